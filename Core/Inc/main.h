@@ -36,7 +36,12 @@ extern "C" {
 
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
-
+typedef enum {
+  ISR_PROFILE_EXTI9_5,
+  ISR_PROFILE_I2C1_EV,
+  ISR_PROFILE_I2C1_ER,
+  ISR_PROFILE_COUNT,
+} isr_profile_t;
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
@@ -54,6 +59,7 @@ void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
 void SystemClock_Config(void);
+void isr_profile_record(isr_profile_t isr, uint32_t cycles);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
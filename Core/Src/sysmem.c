@@ -42,6 +42,9 @@ static uint8_t *__sbrk_heap_end = NULL;
  * @endverbatim
  *
  * This implementation starts allocating at the '_end' linker symbol
+ * The '_Min_Heap_Size' linker symbol bounds the heap, so it can only ever use
+ * what the linker reserved for it; the application allocates from static pools
+ * and arenas, and the newlib heap is only a last resort
  * The '_Min_Stack_Size' linker symbol reserves a memory for the MSP stack
  * The implementation considers '_estack' linker symbol to be RAM end
  * NOTE: If the MSP stack, at any point during execution, grows larger than the
@@ -55,8 +58,10 @@ void *_sbrk(ptrdiff_t incr)
   extern uint8_t _end; /* Symbol defined in the linker script */
   extern uint8_t _estack; /* Symbol defined in the linker script */
   extern uint32_t _Min_Stack_Size; /* Symbol defined in the linker script */
+  extern uint32_t _Min_Heap_Size; /* Symbol defined in the linker script */
   const uint32_t stack_limit = (uint32_t)&_estack - (uint32_t)&_Min_Stack_Size;
-  const uint8_t *max_heap = (uint8_t *)stack_limit;
+  const uint32_t heap_limit = (uint32_t)&_end + (uint32_t)&_Min_Heap_Size;
+  const uint8_t *max_heap = (uint8_t *)(heap_limit < stack_limit ? heap_limit : stack_limit);
   uint8_t *prev_heap_end;
 
   /* Initialize heap end at first call */
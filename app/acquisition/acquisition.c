@@ -0,0 +1,225 @@
+#include "acquisition.h"
+#include <assert.h>
+#include <string.h>
+
+static acquisition_err_t acquisition_timer_get_us(acquisition_t const* acquisition, uint64_t* us)
+{
+    return acquisition->interface.timer_get_us
+               ? acquisition->interface.timer_get_us(acquisition->interface.timer_user, us)
+               : ACQUISITION_ERR_NULL;
+}
+
+static bool acquisition_is_fresh_by_timing(acquisition_device_t const* device, uint64_t now_us)
+{
+    uint64_t ready_us = {};
+
+    if (ina226_get_ready_time(device->ina226, device->last_read_us + 1U, &ready_us) !=
+        INA226_ERR_OK) {
+        return false;
+    }
+
+    return ready_us <= now_us;
+}
+
+static uint64_t acquisition_get_ready_us(acquisition_device_t const* device)
+{
+    return device->ina226->conversion_start_us + device->ina226->conversion_time_us;
+}
+
+static void acquisition_mark_collected(acquisition_device_t* device)
+{
+    device->has_sample = true;
+    device->last_read_us = acquisition_get_ready_us(device);
+    ++device->fresh_reads;
+}
+
+acquisition_err_t acquisition_initialize(acquisition_t* acquisition,
+                                         acquisition_config_t const* config,
+                                         acquisition_interface_t const* interface)
+{
+    assert(acquisition && config && interface);
+
+    memset(acquisition, 0, sizeof(*acquisition));
+    memcpy(&acquisition->config, config, sizeof(*config));
+    memcpy(&acquisition->interface, interface, sizeof(*interface));
+
+    return ACQUISITION_ERR_OK;
+}
+
+acquisition_err_t acquisition_deinitialize(acquisition_t* acquisition)
+{
+    assert(acquisition);
+
+    memset(acquisition, 0, sizeof(*acquisition));
+
+    return ACQUISITION_ERR_OK;
+}
+
+acquisition_err_t acquisition_register_device(acquisition_t* acquisition,
+                                              ina226_t* ina226,
+                                              size_t* index)
+{
+    assert(acquisition && ina226 && index);
+
+    if (acquisition->device_count == ACQUISITION_MAX_DEVICES) {
+        return ACQUISITION_ERR_FAIL;
+    }
+
+    acquisition_device_t* device = &acquisition->devices[acquisition->device_count];
+    memset(device, 0, sizeof(*device));
+    device->ina226 = ina226;
+
+    *index = acquisition->device_count++;
+
+    return ACQUISITION_ERR_OK;
+}
+
+acquisition_err_t acquisition_check_fresh(acquisition_t* acquisition, size_t index, bool* is_fresh)
+{
+    assert(acquisition && is_fresh);
+
+    if (index >= acquisition->device_count) {
+        return ACQUISITION_ERR_FAIL;
+    }
+
+    acquisition_device_t* device = &acquisition->devices[index];
+    uint64_t now_us = {};
+
+    acquisition_err_t err = acquisition_timer_get_us(acquisition, &now_us);
+    if (err != ACQUISITION_ERR_OK) {
+        return err;
+    }
+
+    *is_fresh = !device->has_sample || acquisition_is_fresh_by_timing(device, now_us);
+
+    if (*is_fresh) {
+        device->has_sample = true;
+        device->last_read_us = now_us;
+        ++device->fresh_reads;
+        return ACQUISITION_ERR_OK;
+    }
+
+    ++device->suppressed_reads;
+
+    return acquisition->config.stale_policy == ACQUISITION_STALE_POLICY_DROP ? ACQUISITION_ERR_STALE
+                                                                            : ACQUISITION_ERR_OK;
+}
+
+acquisition_err_t acquisition_trigger_start(acquisition_t* acquisition, acquisition_batch_t* batch)
+{
+    assert(acquisition && batch);
+
+    if (acquisition->device_count == 0U) {
+        return ACQUISITION_ERR_FAIL;
+    }
+
+    // no reads between the writes, so the conversions start as close together as the bus allows
+    for (size_t i = 0U; i < acquisition->device_count; ++i) {
+        if (ina226_trigger(acquisition->devices[i].ina226) != INA226_ERR_OK) {
+            return ACQUISITION_ERR_FAIL;
+        }
+    }
+
+    uint64_t first_us = acquisition->devices[0].ina226->conversion_start_us;
+    uint64_t last_us = first_us;
+    batch->ready_us = 0U;
+
+    // insertion sort by ready time, the devices are few
+    for (size_t i = 0U; i < acquisition->device_count; ++i) {
+        acquisition_device_t const* device = &acquisition->devices[i];
+        uint64_t const start_us = device->ina226->conversion_start_us;
+        uint64_t const ready_us = acquisition_get_ready_us(device);
+
+        if (start_us < first_us) {
+            first_us = start_us;
+        }
+        if (start_us > last_us) {
+            last_us = start_us;
+        }
+        if (ready_us > batch->ready_us) {
+            batch->ready_us = ready_us;
+        }
+
+        size_t n = i;
+        while (n > 0U && acquisition_get_ready_us(&acquisition->devices[batch->order[n - 1U]]) > ready_us) {
+            batch->order[n] = batch->order[n - 1U];
+            --n;
+        }
+        batch->order[n] = (uint8_t)i;
+    }
+
+    batch->timestamp_us = first_us;
+    batch->skew_us = (uint32_t)(last_us - first_us);
+    batch->sample_count = 0U;
+
+    return ACQUISITION_ERR_OK;
+}
+
+acquisition_err_t acquisition_trigger_collected(acquisition_t* acquisition, acquisition_batch_t const* batch)
+{
+    assert(acquisition && batch);
+
+    for (size_t i = 0U; i < acquisition->device_count; ++i) {
+        acquisition_mark_collected(&acquisition->devices[batch->order[i]]);
+    }
+
+    return ACQUISITION_ERR_OK;
+}
+
+acquisition_err_t acquisition_trigger_all(acquisition_t* acquisition, acquisition_batch_t* batch)
+{
+    assert(acquisition && batch);
+
+    acquisition_err_t err = acquisition_trigger_start(acquisition, batch);
+    if (err != ACQUISITION_ERR_OK) {
+        return err;
+    }
+
+    for (size_t n = 0U; n < acquisition->device_count; ++n) {
+        size_t const index = batch->order[n];
+        acquisition_device_t* device = &acquisition->devices[index];
+        acquisition_sample_t* sample = &batch->samples[batch->sample_count];
+
+        if (ina226_wait_ready(device->ina226) != INA226_ERR_OK ||
+            ina226_get_snapshot(device->ina226, &sample->snapshot) != INA226_ERR_OK) {
+            return ACQUISITION_ERR_FAIL;
+        }
+
+        sample->snapshot.is_conversion_ready = true;
+        sample->timestamp_us = batch->timestamp_us;
+        sample->device = (uint8_t)index;
+        sample->flags = 0U;
+
+        acquisition_mark_collected(device);
+        ++batch->sample_count;
+    }
+
+    return ACQUISITION_ERR_OK;
+}
+
+acquisition_err_t acquisition_get_suppressed_reads(acquisition_t const* acquisition,
+                                                   size_t index,
+                                                   uint32_t* suppressed_reads)
+{
+    assert(acquisition && suppressed_reads);
+
+    if (index >= acquisition->device_count) {
+        return ACQUISITION_ERR_FAIL;
+    }
+
+    *suppressed_reads = acquisition->devices[index].suppressed_reads;
+
+    return ACQUISITION_ERR_OK;
+}
+
+acquisition_err_t acquisition_reset_counters(acquisition_t* acquisition)
+{
+    assert(acquisition);
+
+    for (size_t i = 0U; i < acquisition->device_count; ++i) {
+        acquisition->devices[i].fresh_reads = 0U;
+        acquisition->devices[i].suppressed_reads = 0U;
+    }
+
+    return ACQUISITION_ERR_OK;
+}
@@ -0,0 +1,53 @@
+#ifndef ACQUISITION_ACQUISITION_H
+#define ACQUISITION_ACQUISITION_H
+
+#include "acquisition_config.h"
+#include <stdbool.h>
+
+typedef struct {
+    ina226_t* ina226;
+    bool has_sample;
+    uint64_t last_read_us;
+    uint32_t fresh_reads;
+    uint32_t suppressed_reads;
+} acquisition_device_t;
+
+typedef struct {
+    acquisition_config_t config;
+    acquisition_interface_t interface;
+
+    acquisition_device_t devices[ACQUISITION_MAX_DEVICES];
+    size_t device_count;
+} acquisition_t;
+
+acquisition_err_t acquisition_initialize(acquisition_t* acquisition,
+                                         acquisition_config_t const* config,
+                                         acquisition_interface_t const* interface);
+acquisition_err_t acquisition_deinitialize(acquisition_t* acquisition);
+
+acquisition_err_t acquisition_register_device(acquisition_t* acquisition,
+                                              ina226_t* ina226,
+                                              size_t* index);
+
+// decides from the conversion timing whether reading the device now gets a new result, the
+// read itself is up to the caller; a repeat is reported through is_fresh, or dropped with
+// ACQUISITION_ERR_STALE under ACQUISITION_STALE_POLICY_DROP, and both count as suppressed
+acquisition_err_t acquisition_check_fresh(acquisition_t* acquisition, size_t index, bool* is_fresh);
+
+// triggers every registered device back to back (each prepared with ina226_prepare_trigger),
+// then collects the results in ready-time order; all samples carry the batch timestamp and
+// skew_us is the spread between the first and the last CONFIG write
+acquisition_err_t acquisition_trigger_all(acquisition_t* acquisition, acquisition_batch_t* batch);
+
+// the two halves of acquisition_trigger_all for a caller doing the reads itself: start writes
+// the CONFIG registers and fills in timestamp, skew, ready time and collection order, collected
+// marks every device as read at its ready time once the caller has the results
+acquisition_err_t acquisition_trigger_start(acquisition_t* acquisition, acquisition_batch_t* batch);
+acquisition_err_t acquisition_trigger_collected(acquisition_t* acquisition, acquisition_batch_t const* batch);
+
+acquisition_err_t acquisition_get_suppressed_reads(acquisition_t const* acquisition,
+                                                   size_t index,
+                                                   uint32_t* suppressed_reads);
+acquisition_err_t acquisition_reset_counters(acquisition_t* acquisition);
+
+#endif // ACQUISITION_ACQUISITION_H
@@ -0,0 +1,49 @@
+#ifndef ACQUISITION_ACQUISITION_CONFIG_H
+#define ACQUISITION_ACQUISITION_CONFIG_H
+
+#include "ina226.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define ACQUISITION_MAX_DEVICES 8U
+
+typedef enum {
+    ACQUISITION_ERR_OK = 0,
+    ACQUISITION_ERR_FAIL = 1 << 0,
+    ACQUISITION_ERR_NULL = 1 << 1,
+    ACQUISITION_ERR_STALE = 1 << 2,
+} acquisition_err_t;
+
+typedef enum {
+    ACQUISITION_STALE_POLICY_TAG,
+    ACQUISITION_STALE_POLICY_DROP,
+} acquisition_stale_policy_t;
+
+typedef struct {
+    uint64_t timestamp_us;
+    ina226_snapshot_t snapshot;
+    uint8_t device;
+    uint8_t flags;
+} acquisition_sample_t;
+
+typedef struct {
+    uint64_t timestamp_us;
+    uint32_t skew_us;
+    // when the last conversion of the batch completes
+    uint64_t ready_us;
+    // device indices by conversion ready time, the order to collect them in
+    uint8_t order[ACQUISITION_MAX_DEVICES];
+    size_t sample_count;
+    acquisition_sample_t samples[ACQUISITION_MAX_DEVICES];
+} acquisition_batch_t;
+
+typedef struct {
+    acquisition_stale_policy_t stale_policy;
+} acquisition_config_t;
+
+typedef struct {
+    void* timer_user;
+    acquisition_err_t (*timer_get_us)(void*, uint64_t*);
+} acquisition_interface_t;
+
+#endif // ACQUISITION_ACQUISITION_CONFIG_H
@@ -0,0 +1,244 @@
+#include "adaptive.h"
+#include <assert.h>
+#include <string.h>
+
+// roughly doubling the integration time per rung; the conversion time is raised before
+// averaging kicks in, since short conversions are noisier per unit of time
+static adaptive_step_t const adaptive_steps[] = {
+    {INA226_AVERAGING_MODE_1_SAMPLE,
+     INA226_BUS_VOLTAGE_CONVERSION_TIME_140US,
+     INA226_SHUNT_VOLTAGE_CONVERSION_TIME_140US},
+    {INA226_AVERAGING_MODE_1_SAMPLE,
+     INA226_BUS_VOLTAGE_CONVERSION_TIME_332US,
+     INA226_SHUNT_VOLTAGE_CONVERSION_TIME_332US},
+    {INA226_AVERAGING_MODE_1_SAMPLE,
+     INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+     INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1},
+    {INA226_AVERAGING_MODE_4_SAMPLES,
+     INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+     INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1},
+    {INA226_AVERAGING_MODE_16_SAMPLES,
+     INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+     INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1},
+    {INA226_AVERAGING_MODE_64_SAMPLES,
+     INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+     INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1},
+    {INA226_AVERAGING_MODE_256_SAMPLES,
+     INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+     INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1},
+    {INA226_AVERAGING_MODE_1024_SAMPLES,
+     INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+     INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1},
+};
+
+#define ADAPTIVE_STEP_COUNT (sizeof(adaptive_steps) / sizeof(adaptive_steps[0]))
+
+static uint32_t adaptive_step_to_conversion_time_us(size_t index)
+{
+    adaptive_step_t const* step = &adaptive_steps[index];
+
+    return ina226_get_conversion_time_us(step->avg,
+                                         step->vbus_ct,
+                                         step->vsh_ct,
+                                         INA226_OPERATING_MODE_SHUNT_BUS_CONTINUOUS);
+}
+
+// white noise averages down with the shunt integration time
+static float32_t adaptive_step_to_noise_variance(adaptive_t const* adaptive, size_t index)
+{
+    adaptive_step_t const* step = &adaptive_steps[index];
+    uint32_t const integration_us =
+        ina226_avg_to_samples(step->avg) * ina226_vsh_ct_to_conversion_time_us(step->vsh_ct);
+
+    return adaptive->config.noise_variance * (float32_t)ADAPTIVE_REFERENCE_TIME_US / (float32_t)integration_us;
+}
+
+static size_t adaptive_bandwidth_to_max_step(uint32_t bandwidth_hz)
+{
+    uint32_t const max_conversion_time_us = 1000000U / (2U * bandwidth_hz);
+    size_t max_step = 0U;
+
+    for (size_t i = 1U; i < ADAPTIVE_STEP_COUNT; ++i) {
+        if (adaptive_step_to_conversion_time_us(i) <= max_conversion_time_us) {
+            max_step = i;
+        }
+    }
+
+    return max_step;
+}
+
+static void adaptive_reset_window(adaptive_t* adaptive)
+{
+    adaptive->count = 0U;
+    adaptive->mean = 0.0F;
+    adaptive->m2 = 0.0F;
+}
+
+static void adaptive_move_to(adaptive_t* adaptive, size_t step)
+{
+    if (step != adaptive->step) {
+        adaptive->step = step;
+        adaptive->has_change = true;
+    }
+
+    adaptive->vote = 0;
+    adaptive->votes = 0U;
+    adaptive_reset_window(adaptive);
+}
+
+static int8_t adaptive_decide(adaptive_t* adaptive)
+{
+    float32_t const variance = adaptive->m2 / (float32_t)(adaptive->count - 1U);
+    float32_t const expected = adaptive_step_to_noise_variance(adaptive, adaptive->step);
+
+    adaptive->last_ratio = variance / expected;
+
+    if (adaptive->last_ratio > adaptive->config.faster_ratio && adaptive->step > 0U) {
+        return -1;
+    }
+    if (adaptive->last_ratio < adaptive->config.slower_ratio && adaptive->step < adaptive->max_step) {
+        return 1;
+    }
+
+    return 0;
+}
+
+adaptive_err_t adaptive_initialize(adaptive_t* adaptive, adaptive_config_t const* config)
+{
+    assert(adaptive && config);
+
+    if (config->window < 2U || config->initial_step >= ADAPTIVE_STEP_COUNT ||
+        config->noise_variance <= 0.0F || config->slower_ratio >= config->faster_ratio) {
+        return ADAPTIVE_ERR_FAIL;
+    }
+
+    memset(adaptive, 0, sizeof(*adaptive));
+    memcpy(&adaptive->config, config, sizeof(*config));
+
+    adaptive->step = config->initial_step;
+
+    return adaptive_set_bandwidth(adaptive, config->bandwidth_hz);
+}
+
+adaptive_err_t adaptive_deinitialize(adaptive_t* adaptive)
+{
+    assert(adaptive);
+
+    memset(adaptive, 0, sizeof(*adaptive));
+
+    return ADAPTIVE_ERR_OK;
+}
+
+adaptive_err_t adaptive_set_bandwidth(adaptive_t* adaptive, uint32_t bandwidth_hz)
+{
+    assert(adaptive);
+
+    adaptive->config.bandwidth_hz = bandwidth_hz;
+
+    if (bandwidth_hz == 0U) {
+        adaptive->has_change = false;
+        adaptive_reset_window(adaptive);
+        return ADAPTIVE_ERR_OK;
+    }
+
+    adaptive->max_step = adaptive_bandwidth_to_max_step(bandwidth_hz);
+
+    // the device may have been configured by hand meanwhile, so the step is always written
+    adaptive_move_to(adaptive, adaptive->step < adaptive->max_step ? adaptive->step : adaptive->max_step);
+    adaptive->has_change = true;
+
+    return ADAPTIVE_ERR_OK;
+}
+
+adaptive_err_t adaptive_update(adaptive_t* adaptive, float32_t current)
+{
+    assert(adaptive);
+
+    // a decided step that is not applied yet would be judged on the old setting's results
+    if (adaptive->config.bandwidth_hz == 0U || adaptive->has_change) {
+        return ADAPTIVE_ERR_OK;
+    }
+
+    ++adaptive->count;
+    float32_t const delta = current - adaptive->mean;
+    adaptive->mean += delta / (float32_t)adaptive->count;
+    adaptive->m2 += delta * (current - adaptive->mean);
+
+    if (adaptive->count < adaptive->config.window) {
+        return ADAPTIVE_ERR_OK;
+    }
+
+    int8_t const vote = adaptive_decide(adaptive);
+    adaptive_reset_window(adaptive);
+
+    if (vote == 0 || vote != adaptive->vote) {
+        adaptive->vote = vote;
+        adaptive->votes = vote != 0 ? 1U : 0U;
+    } else {
+        ++adaptive->votes;
+    }
+
+    if (adaptive->vote != 0 && adaptive->votes >= adaptive->config.hold_windows) {
+        adaptive_move_to(adaptive, adaptive->vote < 0 ? adaptive->step - 1U : adaptive->step + 1U);
+    }
+
+    return ADAPTIVE_ERR_OK;
+}
+
+bool adaptive_has_change(adaptive_t const* adaptive)
+{
+    assert(adaptive);
+
+    return adaptive->has_change;
+}
+
+adaptive_err_t adaptive_get_change(adaptive_t const* adaptive, ina226_config_reg_t* reg)
+{
+    assert(adaptive && reg);
+
+    if (!adaptive->has_change) {
+        return ADAPTIVE_ERR_FAIL;
+    }
+
+    adaptive_step_t const* step = &adaptive_steps[adaptive->step];
+
+    reg->rst = 0U;
+    reg->avg = step->avg & 0x07U;
+    reg->vbus_ct = step->vbus_ct & 0x07U;
+    reg->vsh_ct = step->vsh_ct & 0x07U;
+
+    return ADAPTIVE_ERR_OK;
+}
+
+adaptive_err_t adaptive_change_applied(adaptive_t* adaptive)
+{
+    assert(adaptive);
+
+    if (!adaptive->has_change) {
+        return ADAPTIVE_ERR_FAIL;
+    }
+
+    adaptive->has_change = false;
+    ++adaptive->changes;
+    adaptive_reset_window(adaptive);
+
+    return ADAPTIVE_ERR_OK;
+}
+
+size_t adaptive_get_step_count(void)
+{
+    return ADAPTIVE_STEP_COUNT;
+}
+
+adaptive_err_t adaptive_get_step(size_t index, adaptive_step_t* step)
+{
+    assert(step);
+
+    if (index >= ADAPTIVE_STEP_COUNT) {
+        return ADAPTIVE_ERR_FAIL;
+    }
+
+    *step = adaptive_steps[index];
+
+    return ADAPTIVE_ERR_OK;
+}
@@ -0,0 +1,46 @@
+#ifndef ADAPTIVE_ADAPTIVE_H
+#define ADAPTIVE_ADAPTIVE_H
+
+#include "adaptive_config.h"
+#include "ina226_registers.h"
+
+typedef struct {
+    adaptive_config_t config;
+
+    size_t step;
+    // slowest step the requested bandwidth allows
+    size_t max_step;
+    bool has_change;
+
+    // running variance over the current window
+    uint32_t count;
+    float32_t mean;
+    float32_t m2;
+
+    // -1 faster, 1 slower, 0 stay, and for how many windows in a row
+    int8_t vote;
+    uint32_t votes;
+
+    float32_t last_ratio;
+    uint32_t changes;
+} adaptive_t;
+
+adaptive_err_t adaptive_initialize(adaptive_t* adaptive, adaptive_config_t const* config);
+adaptive_err_t adaptive_deinitialize(adaptive_t* adaptive);
+
+// 0 disables the controller and leaves the device as it is
+adaptive_err_t adaptive_set_bandwidth(adaptive_t* adaptive, uint32_t bandwidth_hz);
+
+// feeds one fresh current result; results converted before an applied change must not be fed
+adaptive_err_t adaptive_update(adaptive_t* adaptive, float32_t current);
+
+bool adaptive_has_change(adaptive_t const* adaptive);
+// merges the chosen step into reg, keeping its mode; the caller applies it with a single
+// CONFIG write and confirms with adaptive_change_applied, otherwise it stays pending
+adaptive_err_t adaptive_get_change(adaptive_t const* adaptive, ina226_config_reg_t* reg);
+adaptive_err_t adaptive_change_applied(adaptive_t* adaptive);
+
+size_t adaptive_get_step_count(void);
+adaptive_err_t adaptive_get_step(size_t index, adaptive_step_t* step);
+
+#endif // ADAPTIVE_ADAPTIVE_H
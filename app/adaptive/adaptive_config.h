@@ -0,0 +1,41 @@
+#ifndef ADAPTIVE_ADAPTIVE_CONFIG_H
+#define ADAPTIVE_ADAPTIVE_CONFIG_H
+
+#include "ina226_config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// shunt integration time (averages times conversion time) the noise variance is given for
+#define ADAPTIVE_REFERENCE_TIME_US 1100U
+
+typedef enum {
+    ADAPTIVE_ERR_OK = 0,
+    ADAPTIVE_ERR_FAIL = 1 << 0,
+    ADAPTIVE_ERR_NULL = 1 << 1,
+} adaptive_err_t;
+
+typedef struct {
+    // fresh samples per decision, at least 2
+    uint32_t window;
+    // consecutive windows voting the same direction before a step is taken
+    uint32_t hold_windows;
+    // current noise variance at ADAPTIVE_REFERENCE_TIME_US, in the units fed to adaptive_update
+    float32_t noise_variance;
+    // measured over expected noise variance; above faster_ratio the signal itself moves and
+    // needs bandwidth, below slower_ratio it is mostly noise and more averaging pays off
+    float32_t faster_ratio;
+    float32_t slower_ratio;
+    // results have to come at least twice this often; 0 disables the controller
+    uint32_t bandwidth_hz;
+    size_t initial_step;
+} adaptive_config_t;
+
+// one rung of the ladder, ordered by increasing conversion time
+typedef struct {
+    ina226_avg_t avg;
+    ina226_vbus_ct_t vbus_ct;
+    ina226_vsh_ct_t vsh_ct;
+} adaptive_step_t;
+
+#endif // ADAPTIVE_ADAPTIVE_CONFIG_H
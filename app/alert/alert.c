@@ -0,0 +1,229 @@
+#include "alert.h"
+#include <assert.h>
+#include <string.h>
+
+static bool alert_read_pin(alert_t const* alert)
+{
+    // without a pin reader every interrupt is taken as an assertion
+    return alert->interface.pin_is_asserted == NULL || alert->interface.pin_is_asserted(alert->interface.pin_user);
+}
+
+alert_err_t alert_initialize(alert_t* alert, alert_config_t const* config, alert_interface_t const* interface)
+{
+    assert(alert && config && interface);
+
+    if (interface->timer_get_us == NULL) {
+        return ALERT_ERR_NULL;
+    }
+    if (config->rate_max_edges > 0U &&
+        (config->rate_window_us == 0U || interface->pin_mask == NULL || interface->pin_unmask == NULL)) {
+        return ALERT_ERR_FAIL;
+    }
+
+    memset(alert, 0, sizeof(*alert));
+    memcpy(&alert->config, config, sizeof(*config));
+    memcpy(&alert->interface, interface, sizeof(*interface));
+
+    alert->is_asserted = interface->pin_is_asserted && interface->pin_is_asserted(interface->pin_user);
+
+    return ALERT_ERR_OK;
+}
+
+alert_err_t alert_deinitialize(alert_t* alert)
+{
+    assert(alert);
+
+    memset(alert, 0, sizeof(*alert));
+
+    return ALERT_ERR_OK;
+}
+
+alert_err_t alert_register_handler(alert_t* alert, alert_handler_t handler, void* user, size_t* index)
+{
+    assert(alert && handler);
+
+    if (alert->handler_count == ALERT_MAX_HANDLERS) {
+        return ALERT_ERR_FAIL;
+    }
+
+    alert->handlers[alert->handler_count] = (alert_handler_entry_t){.handler = handler, .user = user};
+    if (index) {
+        *index = alert->handler_count;
+    }
+    ++alert->handler_count;
+
+    return ALERT_ERR_OK;
+}
+
+void alert_dispatch(alert_t* alert)
+{
+    assert(alert);
+
+    // the pin interrupt is enabled with the GPIOs, before there is a timebase to stamp with
+    if (alert->interface.timer_get_us == NULL) {
+        return;
+    }
+
+    uint64_t now_us = 0U;
+    alert->interface.timer_get_us(alert->interface.timer_user, &now_us);
+
+    bool const is_asserted = alert_read_pin(alert);
+
+    if (alert->edge_us != 0U && now_us - alert->edge_us < alert->config.chatter_us) {
+        alert->chatter_edges = alert->chatter_edges + 1U;
+    }
+    alert->edge_us = now_us;
+
+    if (alert->config.rate_max_edges > 0U) {
+        if (alert->window_edges == 0U || now_us - alert->window_start_us >= alert->config.rate_window_us) {
+            alert->window_start_us = now_us;
+            alert->window_edges = 0U;
+        }
+        // the line gets masked on the edge that fills the window, alert_poll unmasks it
+        if (++alert->window_edges == alert->config.rate_max_edges) {
+            alert->interface.pin_mask(alert->interface.pin_user);
+            alert->is_rate_limited = true;
+            alert->rate_limits = alert->rate_limits + 1U;
+        }
+    }
+
+    alert->is_asserted = is_asserted;
+    if (!is_asserted) {
+        return;
+    }
+
+    alert->dispatch_us = now_us;
+    alert->dispatches = alert->dispatches + 1U;
+
+    for (size_t i = 0U; i < alert->handler_count; ++i) {
+        alert->handlers[i].handler(alert->handlers[i].user, now_us);
+    }
+}
+
+alert_err_t alert_poll(alert_t* alert, uint64_t now_us)
+{
+    assert(alert);
+
+    if (!alert->is_rate_limited || now_us - alert->window_start_us < alert->config.rate_window_us) {
+        return ALERT_ERR_OK;
+    }
+
+    // the pin is masked, nothing else writes these; edges that came meanwhile are lost, so the
+    // state is taken from the pin before unmasking
+    alert->window_edges = 0U;
+    alert->is_asserted = alert_read_pin(alert);
+    alert->is_rate_limited = false;
+    alert->interface.pin_unmask(alert->interface.pin_user);
+
+    return ALERT_ERR_OK;
+}
+
+alert_err_t alert_set_hysteresis(alert_t* alert, uint16_t trigger_word, uint16_t release_word)
+{
+    assert(alert);
+
+    alert->trigger_word = trigger_word;
+    alert->release_word = release_word;
+    alert->applied_word = trigger_word;
+    alert->is_hysteresis_enabled = true;
+
+    return ALERT_ERR_OK;
+}
+
+alert_err_t alert_clear_hysteresis(alert_t* alert)
+{
+    assert(alert);
+
+    alert->is_hysteresis_enabled = false;
+
+    return ALERT_ERR_OK;
+}
+
+alert_err_t alert_get_limit_change(alert_t const* alert, uint16_t* word)
+{
+    assert(alert && word);
+
+    if (!alert->is_hysteresis_enabled) {
+        return ALERT_ERR_FAIL;
+    }
+
+    uint16_t const wanted = alert->is_asserted ? alert->release_word : alert->trigger_word;
+    if (wanted == alert->applied_word) {
+        return ALERT_ERR_FAIL;
+    }
+
+    *word = wanted;
+
+    return ALERT_ERR_OK;
+}
+
+alert_err_t alert_limit_applied(alert_t* alert, uint16_t word)
+{
+    assert(alert);
+
+    alert->applied_word = word;
+
+    return ALERT_ERR_OK;
+}
+
+alert_err_t alert_get_last_dispatch(alert_t const* alert, uint64_t* dispatch_us, uint32_t* dispatches)
+{
+    assert(alert && dispatch_us);
+
+    uint32_t count = 0U;
+
+    // the 64-bit time takes two loads, retry if a dispatch came in between
+    do {
+        count = alert->dispatches;
+        *dispatch_us = alert->dispatch_us;
+    } while (count != alert->dispatches);
+
+    if (dispatches) {
+        *dispatches = count;
+    }
+
+    return count > 0U ? ALERT_ERR_OK : ALERT_ERR_FAIL;
+}
+
+alert_err_t alert_record_latency(alert_t* alert, uint64_t compare_us, uint64_t dispatch_us)
+{
+    assert(alert);
+
+    if (dispatch_us < compare_us || dispatch_us - compare_us > UINT32_MAX) {
+        return ALERT_ERR_FAIL;
+    }
+
+    uint32_t const latency_us = (uint32_t)(dispatch_us - compare_us);
+
+    if (alert->latency_count == 0U || latency_us < alert->latency_min_us) {
+        alert->latency_min_us = latency_us;
+    }
+    if (latency_us > alert->latency_max_us) {
+        alert->latency_max_us = latency_us;
+    }
+    alert->latency_total_us += latency_us;
+    ++alert->latency_count;
+
+    return ALERT_ERR_OK;
+}
+
+alert_err_t alert_reset_stats(alert_t* alert)
+{
+    assert(alert);
+
+    alert->latency_count = 0U;
+    alert->latency_min_us = 0U;
+    alert->latency_max_us = 0U;
+    alert->latency_total_us = 0U;
+    alert->chatter_edges = 0U;
+    alert->rate_limits = 0U;
+
+    return ALERT_ERR_OK;
+}
+
+bool alert_is_asserted(alert_t const* alert)
+{
+    assert(alert);
+
+    return alert->is_asserted;
+}
@@ -0,0 +1,71 @@
+#ifndef ALERT_ALERT_H
+#define ALERT_ALERT_H
+
+#include "alert_config.h"
+
+typedef struct {
+    alert_handler_t handler;
+    void* user;
+} alert_handler_entry_t;
+
+typedef struct {
+    alert_config_t config;
+    alert_interface_t interface;
+
+    alert_handler_entry_t handlers[ALERT_MAX_HANDLERS];
+    size_t handler_count;
+
+    // written by alert_dispatch
+    volatile uint32_t dispatches;
+    volatile uint64_t dispatch_us;
+
+    // pin state as of the latest edge, or as read back after the rate cap lifted
+    volatile bool is_asserted;
+    uint64_t edge_us;
+    uint64_t window_start_us;
+    uint32_t window_edges;
+    volatile bool is_rate_limited;
+    volatile uint32_t chatter_edges;
+    volatile uint32_t rate_limits;
+
+    // with hysteresis the limit is trigger_word while released and release_word while asserted
+    bool is_hysteresis_enabled;
+    uint16_t trigger_word;
+    uint16_t release_word;
+    uint16_t applied_word;
+
+    // from the comparison inside the device to the dispatch
+    uint32_t latency_count;
+    uint32_t latency_min_us;
+    uint32_t latency_max_us;
+    uint64_t latency_total_us;
+} alert_t;
+
+alert_err_t alert_initialize(alert_t* alert, alert_config_t const* config, alert_interface_t const* interface);
+alert_err_t alert_deinitialize(alert_t* alert);
+
+// handlers run in registration order; register them all before the pin interrupt is enabled
+alert_err_t alert_register_handler(alert_t* alert, alert_handler_t handler, void* user, size_t* index);
+
+// from the pin interrupt on either edge: timestamps it, counts chatter, applies the rate cap and
+// runs every handler when the line asserted
+void alert_dispatch(alert_t* alert);
+
+// from the task side: lifts the rate cap once its window is over
+alert_err_t alert_poll(alert_t* alert, uint64_t now_us);
+
+// the device limit is at trigger_word when hysteresis gets enabled
+alert_err_t alert_set_hysteresis(alert_t* alert, uint16_t trigger_word, uint16_t release_word);
+alert_err_t alert_clear_hysteresis(alert_t* alert);
+
+// the limit word the device should have for the current pin state, fails when it already has it
+alert_err_t alert_get_limit_change(alert_t const* alert, uint16_t* word);
+alert_err_t alert_limit_applied(alert_t* alert, uint16_t word);
+
+// the latest dispatch time, read consistently against a dispatch interrupting the read
+alert_err_t alert_get_last_dispatch(alert_t const* alert, uint64_t* dispatch_us, uint32_t* dispatches);
+alert_err_t alert_record_latency(alert_t* alert, uint64_t compare_us, uint64_t dispatch_us);
+alert_err_t alert_reset_stats(alert_t* alert);
+bool alert_is_asserted(alert_t const* alert);
+
+#endif // ALERT_ALERT_H
@@ -0,0 +1,40 @@
+#ifndef ALERT_ALERT_CONFIG_H
+#define ALERT_ALERT_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ALERT_MAX_HANDLERS 4U
+
+typedef enum {
+    ALERT_ERR_OK = 0,
+    ALERT_ERR_FAIL = 1 << 0,
+    ALERT_ERR_NULL = 1 << 1,
+} alert_err_t;
+
+// runs in interrupt context, with the time the pin was serviced
+typedef void (*alert_handler_t)(void*, uint64_t);
+
+typedef struct {
+    // an edge this soon after the previous one counts as chatter
+    uint32_t chatter_us;
+    // at most rate_max_edges pin interrupts per rate_window_us, 0 for no cap; past that the
+    // line stays masked for the rest of the window and the state is read back from the pin
+    uint32_t rate_window_us;
+    uint32_t rate_max_edges;
+} alert_config_t;
+
+typedef struct {
+    void* timer_user;
+    alert_err_t (*timer_get_us)(void*, uint64_t*);
+
+    // the pin interrupts on both edges; is_asserted tells which one it was
+    void* pin_user;
+    bool (*pin_is_asserted)(void*);
+    // mask and unmask the pin interrupt, unmasking drops an edge that came while masked
+    void (*pin_mask)(void*);
+    void (*pin_unmask)(void*);
+} alert_interface_t;
+
+#endif // ALERT_ALERT_CONFIG_H
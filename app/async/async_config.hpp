@@ -0,0 +1,42 @@
+#ifndef ASYNC_ASYNC_CONFIG_HPP
+#define ASYNC_ASYNC_CONFIG_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace async {
+
+    // coroutine frames come from a fixed block pool, sized for the largest coroutine in the app
+    inline constexpr std::size_t FRAME_SIZE = 512U;
+    inline constexpr std::size_t FRAME_COUNT = 4U;
+
+    inline constexpr std::size_t MAX_ROOT_TASKS = 4U;
+    inline constexpr std::size_t MAX_READY = 8U;
+    inline constexpr std::size_t MAX_PENDING = 16U;
+    // a root task and whatever it awaits down its chain park on one completion at a time, so
+    // with a slot per root executor::wait never runs out and never resumes a waiter early
+    static_assert(MAX_PENDING >= MAX_ROOT_TASKS);
+
+    inline constexpr std::size_t PIPELINE_MAX_DEVICES = 4U;
+    inline constexpr std::size_t PIPELINE_BLOCK_COUNT = 2U;
+
+    enum struct err : std::uint8_t {
+        ok = 0,
+        fail = 1 << 0,
+        null = 1 << 1,
+        capacity = 1 << 2,
+    };
+
+    struct i2c_interface {
+        void* user;
+        err (*start_read)(void*, std::uint8_t, std::uint8_t, std::uint8_t*, std::size_t);
+        err (*start_write)(void*, std::uint8_t, std::uint8_t, std::uint8_t const*, std::size_t);
+        void (*critical_enter)(void*);
+        void (*critical_exit)(void*);
+        // optional, enables the bus busy-time accounting
+        std::uint32_t (*get_cycles)(void*);
+    };
+
+} // namespace async
+
+#endif // ASYNC_ASYNC_CONFIG_HPP
@@ -0,0 +1,127 @@
+#include "executor.hpp"
+#include "memory_sections.h"
+
+namespace async {
+
+    err executor::spawn(task<void>&& root) noexcept
+    {
+        if (!root.valid()) {
+            ++failures_;
+            return err::null;
+        }
+
+        for (auto& slot : roots_) {
+            if (slot) {
+                continue;
+            }
+
+            auto handle = root.release();
+            err const result = schedule(handle);
+            if (result != err::ok) {
+                handle.destroy();
+                return result;
+            }
+            slot = handle;
+            return err::ok;
+        }
+
+        ++failures_;
+        return err::capacity;
+    }
+
+    err executor::schedule(std::coroutine_handle<> handle) noexcept
+    {
+        if (ready_count_ == MAX_READY) {
+            ++failures_;
+            return err::capacity;
+        }
+
+        ready_[(ready_head_ + ready_count_++) % MAX_READY] = handle;
+
+        return err::ok;
+    }
+
+    bool executor::wait(completion& completion, std::coroutine_handle<> handle) noexcept
+    {
+        if (pending_count_ == MAX_PENDING) {
+            // cannot happen while every waiter is a root task chain, see MAX_PENDING; resume
+            // right away rather than lose the waiter, the operation reports its own state
+            ++failures_;
+            return false;
+        }
+
+        completion.waiter = handle;
+        pending_[pending_count_++] = &completion;
+
+        // an interrupt that completed before the registration has already called wake, so
+        // nobody would come back for it
+        if (completion.is_done.load(std::memory_order_acquire)) {
+            --pending_count_;
+            return false;
+        }
+
+        return true;
+    }
+
+    MEMORY_RAMFUNC void executor::complete(completion& completion) noexcept
+    {
+        completion.is_done.store(true, std::memory_order_release);
+        wake();
+    }
+
+    void executor::run() noexcept
+    {
+        // only what is ready now, so a coroutine that keeps yielding cannot starve the loop
+        for (std::size_t count = ready_count_; count > 0U; --count) {
+            auto handle = ready_[ready_head_];
+            ready_head_ = (ready_head_ + 1U) % MAX_READY;
+            --ready_count_;
+            handle.resume();
+        }
+
+        for (std::size_t i = 0U; i < pending_count_;) {
+            completion* done = pending_[i];
+            if (!done->is_done.load(std::memory_order_acquire)) {
+                ++i;
+                continue;
+            }
+
+            // unlink before resuming, the waiter may park on something else straight away
+            pending_[i] = pending_[--pending_count_];
+            done->waiter.resume();
+        }
+
+        for (auto& root : roots_) {
+            if (root && root.done()) {
+                root.destroy();
+                root = {};
+            }
+        }
+
+        if (ready_count_ > 0U) {
+            wake();
+        }
+    }
+
+    std::size_t executor::get_root_count() const noexcept
+    {
+        std::size_t count = 0U;
+        for (auto const& root : roots_) {
+            count += root ? 1U : 0U;
+        }
+        return count;
+    }
+
+    std::uint32_t executor::get_failures() const noexcept
+    {
+        return failures_;
+    }
+
+    void executor::wake() noexcept
+    {
+        if (wake_ != nullptr) {
+            wake_(wake_user_);
+        }
+    }
+
+} // namespace async
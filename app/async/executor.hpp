@@ -0,0 +1,140 @@
+#ifndef ASYNC_EXECUTOR_HPP
+#define ASYNC_EXECUTOR_HPP
+
+#include "async_config.hpp"
+#include "task.hpp"
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+namespace async {
+
+    // set from interrupt context when an operation finishes; the waiting coroutine is resumed
+    // by the executor on the next run
+    struct completion {
+        std::atomic<bool> is_done{false};
+        std::coroutine_handle<> waiter{};
+    };
+
+    // single-threaded executor driven from the main loop; interrupts only ever touch the
+    // completion flags and the wake hook
+    class executor {
+    public:
+        using wake_hook = void (*)(void*);
+
+        constexpr executor(void* wake_user, wake_hook wake_handler) noexcept :
+            wake_user_{wake_user}, wake_{wake_handler}
+        {}
+
+        executor(executor const&) = delete;
+        executor& operator=(executor const&) = delete;
+
+        // takes ownership of a top-level task and starts it on the next run; the frame is
+        // released once the task finishes
+        err spawn(task<void>&& root) noexcept;
+
+        err schedule(std::coroutine_handle<> handle) noexcept;
+
+        // parks handle until completion is done; false means it already is and the caller should
+        // not suspend
+        bool wait(completion& completion, std::coroutine_handle<> handle) noexcept;
+
+        // interrupt-safe
+        void complete(completion& completion) noexcept;
+
+        // resumes everything that became ready since the last call
+        void run() noexcept;
+
+        [[nodiscard]] std::size_t get_root_count() const noexcept;
+        [[nodiscard]] std::uint32_t get_failures() const noexcept;
+
+        // awaitable that requeues the caller behind everything already ready
+        struct yield_awaiter {
+            executor& owner;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) const noexcept
+            {
+                return owner.schedule(handle) == err::ok;
+            }
+
+            void await_resume() const noexcept
+            {}
+        };
+
+        [[nodiscard]] yield_awaiter yield() noexcept
+        {
+            return {*this};
+        }
+
+    private:
+        void wake() noexcept;
+
+        void* wake_user_;
+        wake_hook wake_;
+
+        std::array<std::coroutine_handle<>, MAX_ROOT_TASKS> roots_{};
+
+        std::array<std::coroutine_handle<>, MAX_READY> ready_{};
+        std::size_t ready_head_{0U};
+        std::size_t ready_count_{0U};
+
+        std::array<completion*, MAX_PENDING> pending_{};
+        std::size_t pending_count_{0U};
+
+        std::uint32_t failures_{0U};
+    };
+
+    // auto-reset event an interrupt can raise and one coroutine can await
+    class event {
+    public:
+        explicit constexpr event(executor& owner) noexcept : owner_{owner}
+        {}
+
+        event(event const&) = delete;
+        event& operator=(event const&) = delete;
+
+        // interrupt-safe
+        void set() noexcept
+        {
+            owner_.complete(completion_);
+        }
+
+        struct awaiter {
+            event& source;
+
+            bool await_ready() const noexcept
+            {
+                return source.completion_.is_done.exchange(false, std::memory_order_acquire);
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) const noexcept
+            {
+                return source.owner_.wait(source.completion_, handle);
+            }
+
+            void await_resume() const noexcept
+            {
+                source.completion_.is_done.store(false, std::memory_order_relaxed);
+            }
+        };
+
+        awaiter operator co_await() noexcept
+        {
+            return {*this};
+        }
+
+    private:
+        executor& owner_;
+        completion completion_{};
+    };
+
+} // namespace async
+
+#endif // ASYNC_EXECUTOR_HPP
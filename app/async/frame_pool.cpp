@@ -0,0 +1,18 @@
+#include "frame_pool.hpp"
+#include "memory_sections.h"
+
+namespace async {
+
+    namespace {
+
+        // frames are touched from the I2C completion path, keep them next to the rest of the ISR state
+        MEMORY_SRAM2 constinit memory::static_block_pool<FRAME_SIZE, FRAME_COUNT> pool{"frames"};
+
+    } // namespace
+
+    memory::block_pool& frame_pool() noexcept
+    {
+        return pool;
+    }
+
+} // namespace async
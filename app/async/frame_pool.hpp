@@ -0,0 +1,14 @@
+#ifndef ASYNC_FRAME_POOL_HPP
+#define ASYNC_FRAME_POOL_HPP
+
+#include "async_config.hpp"
+#include "block_pool.hpp"
+
+namespace async {
+
+    // coroutine frames are only created and destroyed from the main loop
+    [[nodiscard]] memory::block_pool& frame_pool() noexcept;
+
+} // namespace async
+
+#endif // ASYNC_FRAME_POOL_HPP
@@ -0,0 +1,140 @@
+#include "i2c_transport.hpp"
+#include "memory_sections.h"
+#include <cassert>
+
+namespace async {
+
+    i2c_transfer::i2c_transfer(i2c_transport& bus,
+                               direction dir,
+                               std::uint8_t address,
+                               std::uint8_t reg,
+                               std::uint8_t* data,
+                               std::size_t size) noexcept :
+        bus_{bus}, direction_{dir}, address_{address}, reg_{reg}, data_{data}, size_{size}
+    {}
+
+    i2c_transfer::~i2c_transfer()
+    {
+        assert(!is_submitted_ || is_done());
+    }
+
+    void i2c_transfer::submit() noexcept
+    {
+        if (is_submitted_) {
+            return;
+        }
+
+        is_submitted_ = true;
+        bus_.enqueue(*this);
+    }
+
+    bool i2c_transfer::await_ready() noexcept
+    {
+        submit();
+
+        return is_done();
+    }
+
+    bool i2c_transfer::await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        return bus_.owner_.wait(completion_, handle);
+    }
+
+    err i2c_transfer::await_resume() const noexcept
+    {
+        // the executor resumes early only when it ran out of pending slots
+        return is_done() ? status_ : err::capacity;
+    }
+
+    i2c_transport::i2c_transport(executor& owner, i2c_interface const& interface) noexcept :
+        owner_{owner}, interface_{interface}
+    {}
+
+    // complete, start_head and finish_head run in the I2C interrupt
+    MEMORY_RAMFUNC void i2c_transport::complete(bool is_ok) noexcept
+    {
+        if (head_ == nullptr) {
+            return;
+        }
+
+        finish_head(is_ok ? err::ok : err::fail);
+        start_head();
+    }
+
+    void i2c_transport::enqueue(i2c_transfer& transfer) noexcept
+    {
+        critical_enter();
+
+        transfer.next_ = nullptr;
+        if (tail_ != nullptr) {
+            tail_->next_ = &transfer;
+            tail_ = &transfer;
+        } else {
+            head_ = tail_ = &transfer;
+            start_head();
+        }
+
+        critical_exit();
+    }
+
+    MEMORY_RAMFUNC void i2c_transport::start_head() noexcept
+    {
+        while (head_ != nullptr) {
+            i2c_transfer& transfer = *head_;
+
+            err status = err::null;
+            started_cycles_ = get_cycles();
+            if (transfer.direction_ == i2c_transfer::direction::read) {
+                if (interface_.start_read != nullptr) {
+                    status = interface_.start_read(interface_.user, transfer.address_, transfer.reg_, transfer.data_, transfer.size_);
+                }
+            } else if (interface_.start_write != nullptr) {
+                status = interface_.start_write(interface_.user, transfer.address_, transfer.reg_, transfer.data_, transfer.size_);
+            }
+            if (status == err::ok) {
+                return;
+            }
+
+            finish_head(status);
+        }
+    }
+
+    MEMORY_RAMFUNC void i2c_transport::finish_head(err status) noexcept
+    {
+        i2c_transfer& transfer = *head_;
+
+        head_ = transfer.next_;
+        if (head_ == nullptr) {
+            tail_ = nullptr;
+        }
+
+        busy_cycles_ = busy_cycles_ + (get_cycles() - started_cycles_);
+        transfers_ = transfers_ + 1U;
+        if (status != err::ok) {
+            errors_ = errors_ + 1U;
+        }
+
+        transfer.status_ = status;
+        owner_.complete(transfer.completion_);
+    }
+
+    void i2c_transport::critical_enter() noexcept
+    {
+        if (interface_.critical_enter != nullptr) {
+            interface_.critical_enter(interface_.user);
+        }
+    }
+
+    void i2c_transport::critical_exit() noexcept
+    {
+        if (interface_.critical_exit != nullptr) {
+            interface_.critical_exit(interface_.user);
+        }
+    }
+
+    std::uint32_t i2c_transport::get_cycles() const noexcept
+    {
+        return interface_.get_cycles != nullptr ? interface_.get_cycles(interface_.user) : 0U;
+    }
+
+} // namespace async
@@ -0,0 +1,129 @@
+#ifndef ASYNC_I2C_TRANSPORT_HPP
+#define ASYNC_I2C_TRANSPORT_HPP
+
+#include "async_config.hpp"
+#include "executor.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+
+namespace async {
+
+    class i2c_transport;
+
+    // one register transaction; it is also its own awaiter and stays linked into the transport
+    // queue until it completes, so it must not move once submitted
+    class i2c_transfer {
+    public:
+        enum struct direction : std::uint8_t {
+            read,
+            write,
+        };
+
+        i2c_transfer(i2c_transport& bus,
+                     direction dir,
+                     std::uint8_t address,
+                     std::uint8_t reg,
+                     std::uint8_t* data,
+                     std::size_t size) noexcept;
+
+        i2c_transfer(i2c_transfer const&) = delete;
+        i2c_transfer& operator=(i2c_transfer const&) = delete;
+
+        // the interrupt still writes to a queued transfer, so it has to outlive the bus work
+        ~i2c_transfer();
+
+        // queues the transaction without waiting for it, so several can be in flight
+        void submit() noexcept;
+
+        [[nodiscard]] bool is_done() const noexcept
+        {
+            return completion_.is_done.load(std::memory_order_acquire);
+        }
+
+        bool await_ready() noexcept;
+        bool await_suspend(std::coroutine_handle<> handle) noexcept;
+        err await_resume() const noexcept;
+
+    private:
+        friend class i2c_transport;
+
+        i2c_transport& bus_;
+        direction direction_;
+        std::uint8_t address_;
+        std::uint8_t reg_;
+        std::uint8_t* data_;
+        std::size_t size_;
+
+        i2c_transfer* next_{nullptr};
+        bool is_submitted_{false};
+        err status_{err::ok};
+        completion completion_{};
+    };
+
+    // serialises transfers on one interrupt-driven bus; the next queued transfer is started
+    // straight from the completion interrupt, so back-to-back transfers leave no idle gap for
+    // the main loop to fill
+    class i2c_transport {
+    public:
+        i2c_transport(executor& owner, i2c_interface const& interface) noexcept;
+
+        i2c_transport(i2c_transport const&) = delete;
+        i2c_transport& operator=(i2c_transport const&) = delete;
+
+        [[nodiscard]] i2c_transfer read(std::uint8_t address, std::uint8_t reg, std::uint8_t* data, std::size_t size) noexcept
+        {
+            return {*this, i2c_transfer::direction::read, address, reg, data, size};
+        }
+
+        [[nodiscard]] i2c_transfer write(std::uint8_t address, std::uint8_t reg, std::uint8_t* data, std::size_t size) noexcept
+        {
+            return {*this, i2c_transfer::direction::write, address, reg, data, size};
+        }
+
+        // called from the bus completion and error interrupts
+        void complete(bool is_ok) noexcept;
+
+        [[nodiscard]] std::uint32_t get_transfers() const noexcept
+        {
+            return transfers_;
+        }
+
+        [[nodiscard]] std::uint32_t get_errors() const noexcept
+        {
+            return errors_;
+        }
+
+        // cycles the bus spent with a transfer in flight, wrapping; callers take differences
+        [[nodiscard]] std::uint32_t get_busy_cycles() const noexcept
+        {
+            return busy_cycles_;
+        }
+
+    private:
+        friend class i2c_transfer;
+
+        void enqueue(i2c_transfer& transfer) noexcept;
+        // with the queue lock held or from the completion interrupt
+        void start_head() noexcept;
+        void finish_head(err status) noexcept;
+
+        void critical_enter() noexcept;
+        void critical_exit() noexcept;
+        std::uint32_t get_cycles() const noexcept;
+
+        executor& owner_;
+        i2c_interface interface_;
+
+        i2c_transfer* head_{nullptr};
+        i2c_transfer* tail_{nullptr};
+
+        volatile std::uint32_t transfers_{0U};
+        volatile std::uint32_t errors_{0U};
+        volatile std::uint32_t busy_cycles_{0U};
+        std::uint32_t started_cycles_{0U};
+    };
+
+} // namespace async
+
+#endif // ASYNC_I2C_TRANSPORT_HPP
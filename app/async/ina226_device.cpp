@@ -0,0 +1,76 @@
+#include "ina226_device.hpp"
+
+namespace async {
+
+    ina226_device::register_read::register_read(i2c_transport& bus,
+                                                std::uint8_t address,
+                                                ina226_reg_address_t reg) noexcept :
+        transfer_{bus.read(address, static_cast<std::uint8_t>(reg), data_, sizeof(data_))}
+    {}
+
+    std::expected<std::uint16_t, ina226_err_t> ina226_device::register_read::await_resume() const noexcept
+    {
+        if (transfer_.await_resume() != err::ok) {
+            return std::unexpected{INA226_ERR_FAIL};
+        }
+
+        // registers are sent MSB first
+        return static_cast<std::uint16_t>((data_[0] << 8U) | data_[1]);
+    }
+
+    ina226_device::register_write::register_write(i2c_transport& bus,
+                                                  std::uint8_t address,
+                                                  ina226_reg_address_t reg,
+                                                  std::uint16_t value) noexcept :
+        data_{static_cast<std::uint8_t>(value >> 8U), static_cast<std::uint8_t>(value & 0xFFU)},
+        transfer_{bus.write(address, static_cast<std::uint8_t>(reg), data_, sizeof(data_))}
+    {}
+
+    ina226_device::snapshot_read::snapshot_read(i2c_transport& bus, std::uint8_t address) noexcept :
+        shunt_voltage_{bus, address, INA226_REG_ADDRESS_SHUNT_VOLTAGE},
+        bus_voltage_{bus, address, INA226_REG_ADDRESS_BUS_VOLTAGE},
+        power_{bus, address, INA226_REG_ADDRESS_POWER},
+        current_{bus, address, INA226_REG_ADDRESS_CURRENT}
+    {}
+
+    void ina226_device::snapshot_read::submit() noexcept
+    {
+        shunt_voltage_.submit();
+        bus_voltage_.submit();
+        power_.submit();
+        current_.submit();
+    }
+
+    bool ina226_device::snapshot_read::await_ready() noexcept
+    {
+        submit();
+
+        return shunt_voltage_.is_done() && bus_voltage_.is_done() && power_.is_done() && current_.await_ready();
+    }
+
+    // the bus runs the queue in order, so the last register done means all of them are; the
+    // caller must not resume earlier, the temporary holding the transfers goes away with it
+    bool ina226_device::snapshot_read::await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        return current_.await_suspend(handle);
+    }
+
+    std::expected<ina226_snapshot_t, ina226_err_t> ina226_device::snapshot_read::await_resume() const noexcept
+    {
+        auto const shunt_voltage = shunt_voltage_.await_resume();
+        auto const bus_voltage = bus_voltage_.await_resume();
+        auto const current = current_.await_resume();
+        auto const power = power_.await_resume();
+
+        if (!shunt_voltage || !bus_voltage || !current || !power) {
+            return std::unexpected{INA226_ERR_FAIL};
+        }
+
+        return ina226_snapshot_t{.shunt_voltage = static_cast<std::int16_t>(*shunt_voltage),
+                                 .bus_voltage = static_cast<std::int16_t>(*bus_voltage),
+                                 .current = static_cast<std::int16_t>(*current),
+                                 .power = static_cast<std::int16_t>(*power),
+                                 .is_conversion_ready = false};
+    }
+
+} // namespace async
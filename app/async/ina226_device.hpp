@@ -0,0 +1,124 @@
+#ifndef ASYNC_INA226_DEVICE_HPP
+#define ASYNC_INA226_DEVICE_HPP
+
+#include "i2c_transport.hpp"
+#include <coroutine>
+#include <cstdint>
+#include <expected>
+
+extern "C" {
+#include "ina226.h"
+}
+
+namespace async {
+
+    // awaitable front-end for one INA226 on an interrupt-driven bus; all operations are plain
+    // awaiters, so reading a device costs no coroutine frame
+    class ina226_device {
+    public:
+        class register_read {
+        public:
+            register_read(i2c_transport& bus, std::uint8_t address, ina226_reg_address_t reg) noexcept;
+
+            void submit() noexcept
+            {
+                transfer_.submit();
+            }
+
+            [[nodiscard]] bool is_done() const noexcept
+            {
+                return transfer_.is_done();
+            }
+
+            bool await_ready() noexcept
+            {
+                return transfer_.await_ready();
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                return transfer_.await_suspend(handle);
+            }
+
+            std::expected<std::uint16_t, ina226_err_t> await_resume() const noexcept;
+
+        private:
+            std::uint8_t data_[2]{};
+            i2c_transfer transfer_;
+        };
+
+        class register_write {
+        public:
+            register_write(i2c_transport& bus, std::uint8_t address, ina226_reg_address_t reg, std::uint16_t value) noexcept;
+
+            bool await_ready() noexcept
+            {
+                return transfer_.await_ready();
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                return transfer_.await_suspend(handle);
+            }
+
+            ina226_err_t await_resume() const noexcept
+            {
+                return transfer_.await_resume() == err::ok ? INA226_ERR_OK : INA226_ERR_FAIL;
+            }
+
+        private:
+            std::uint8_t data_[2]{};
+            i2c_transfer transfer_;
+        };
+
+        // the four result registers queued back to back; submit() starts them early so the
+        // transfers of several devices can be chained before anything is awaited
+        class snapshot_read {
+        public:
+            snapshot_read(i2c_transport& bus, std::uint8_t address) noexcept;
+
+            void submit() noexcept;
+
+            bool await_ready() noexcept;
+            bool await_suspend(std::coroutine_handle<> handle) noexcept;
+            // is_conversion_ready is always false, CVRF is not read on this path
+            std::expected<ina226_snapshot_t, ina226_err_t> await_resume() const noexcept;
+
+        private:
+            register_read shunt_voltage_;
+            register_read bus_voltage_;
+            register_read power_;
+            register_read current_;
+        };
+
+        ina226_device(i2c_transport& bus, ina226_slave_address_t address) noexcept : bus_{bus}, address_{address}
+        {}
+
+        [[nodiscard]] std::uint8_t get_address() const noexcept
+        {
+            return address_;
+        }
+
+        [[nodiscard]] register_read read_register(ina226_reg_address_t reg) const noexcept
+        {
+            return {bus_, address_, reg};
+        }
+
+        [[nodiscard]] register_write write_register(ina226_reg_address_t reg, std::uint16_t value) const noexcept
+        {
+            return {bus_, address_, reg, value};
+        }
+
+        [[nodiscard]] snapshot_read read_snapshot() const noexcept
+        {
+            return {bus_, address_};
+        }
+
+    private:
+        i2c_transport& bus_;
+        std::uint8_t address_;
+    };
+
+} // namespace async
+
+#endif // ASYNC_INA226_DEVICE_HPP
@@ -0,0 +1,261 @@
+#include "pipeline.hpp"
+#include "memory_sections.h"
+#include <algorithm>
+#include <cassert>
+
+namespace async {
+
+    namespace {
+
+        constexpr std::array<ina226_reg_address_t, 4U> PIPELINE_REGISTERS = {
+            INA226_REG_ADDRESS_SHUNT_VOLTAGE,
+            INA226_REG_ADDRESS_BUS_VOLTAGE,
+            INA226_REG_ADDRESS_POWER,
+            INA226_REG_ADDRESS_CURRENT,
+        };
+
+        MEMORY_RAMFUNC std::int16_t decode_register(std::uint8_t const (&raw)[2]) noexcept
+        {
+            // registers are sent MSB first
+            return static_cast<std::int16_t>((raw[0] << 8U) | raw[1]);
+        }
+
+    } // namespace
+
+    pipeline::pipeline(i2c_transport& bus, pipeline_interface const& interface) noexcept :
+        bus_{bus}, interface_{interface}
+    {}
+
+    err pipeline::add_device(ina226_device const& device, ina226_t const& driver) noexcept
+    {
+        if (channel_count_ == PIPELINE_MAX_DEVICES) {
+            return err::capacity;
+        }
+
+        order_[channel_count_] = static_cast<std::uint8_t>(channel_count_);
+        channel& added = channels_[channel_count_++];
+        added.address = device.get_address();
+        added.current_scale = driver.config.current_scale;
+        added.power_scale = ina226_current_to_power_scale(driver.config.current_scale);
+
+        return err::ok;
+    }
+
+    err pipeline::set_read_order(std::uint8_t const* order, std::size_t count) noexcept
+    {
+        if (order == nullptr) {
+            return err::null;
+        }
+        if (count != channel_count_) {
+            return err::fail;
+        }
+
+        std::uint8_t seen{};
+        for (std::size_t i = 0U; i < count; ++i) {
+            if (order[i] >= channel_count_ || (seen & (1U << order[i]))) {
+                return err::fail;
+            }
+            seen = static_cast<std::uint8_t>(seen | (1U << order[i]));
+        }
+
+        std::copy_n(order, count, order_.begin());
+
+        return err::ok;
+    }
+
+    task<void> pipeline::run(event& tick) noexcept
+    {
+        for (;;) {
+            co_await tick;
+
+            std::uint64_t timestamp_us{};
+            std::uint32_t tag{};
+            std::uint8_t stale_mask{};
+            if (channel_count_ == 0U || interface_.begin_block == nullptr ||
+                !interface_.begin_block(interface_.user, &timestamp_us, &tag, &stale_mask)) {
+                continue;
+            }
+
+            std::uint32_t const started = get_cycles();
+            if (has_started_) {
+                stats_.window_cycles += started - last_start_cycles_;
+            }
+            has_started_ = true;
+            last_start_cycles_ = started;
+
+            // both blocks still wait for the aggregate stage, better to skip the bus altogether
+            sample_block* block = claim_block();
+            if (block == nullptr) {
+                ++stats_.dropped_blocks;
+                continue;
+            }
+
+            std::uint32_t const busy_before = bus_.get_busy_cycles();
+
+            block->stale_mask = stale_mask;
+            submit_transfers(stale_mask);
+
+            for (std::size_t n = 0U; n < channel_count_; ++n) {
+                std::size_t const i = order_[n];
+                if (stale_mask & (1U << i)) {
+                    continue;
+                }
+
+                // every transfer has to be off the queue before the next tick emplaces over it,
+                // so wait on each one instead of trusting the order on the bus
+                for (auto& transfer : channels_[i].transfers) {
+                    i2c_transfer& queued = *transfer;
+                    while (!queued.is_done()) {
+                        co_await queued;
+                    }
+                }
+                decode(i, *block);
+            }
+
+            block->timestamp_us = timestamp_us;
+            block->tag = tag;
+            publish_block(*block, started, busy_before);
+        }
+    }
+
+    std::size_t pipeline::aggregate() noexcept
+    {
+        std::size_t count = 0U;
+
+        while (block_states_[read_index_] == block_state::ready) {
+            std::uint32_t const started = get_cycles();
+            if (interface_.aggregate != nullptr) {
+                interface_.aggregate(interface_.user, blocks_[read_index_]);
+            }
+            record(stats_.aggregate, get_cycles() - started);
+
+            block_states_[read_index_] = block_state::free;
+            read_index_ = (read_index_ + 1U) % PIPELINE_BLOCK_COUNT;
+            ++count;
+        }
+
+        return count;
+    }
+
+    pipeline::stats pipeline::get_stats() const noexcept
+    {
+        return stats_;
+    }
+
+    void pipeline::reset_stats() noexcept
+    {
+        stats_ = {};
+        has_started_ = false;
+    }
+
+    std::uint32_t pipeline::get_utilization_ppm(stage_stats const& stage, std::uint64_t window_cycles) noexcept
+    {
+        if (window_cycles == 0U) {
+            return 0U;
+        }
+
+        std::uint64_t const ppm = stage.busy_cycles * 1000000U / window_cycles;
+
+        return ppm > 1000000U ? 1000000U : static_cast<std::uint32_t>(ppm);
+    }
+
+    void pipeline::submit_transfers(std::uint8_t stale_mask) noexcept
+    {
+        for (std::size_t n = 0U; n < channel_count_; ++n) {
+            std::size_t const i = order_[n];
+            if (stale_mask & (1U << i)) {
+                continue;
+            }
+
+            channel& current = channels_[i];
+
+            for (std::size_t reg = 0U; reg < REGISTER_COUNT; ++reg) {
+                assert(!current.transfers[reg].has_value() || current.transfers[reg]->is_done());
+                current.transfers[reg].emplace(bus_,
+                                               i2c_transfer::direction::read,
+                                               current.address,
+                                               static_cast<std::uint8_t>(PIPELINE_REGISTERS[reg]),
+                                               current.raw[reg],
+                                               sizeof(current.raw[reg]));
+                current.transfers[reg]->submit();
+            }
+        }
+    }
+
+    MEMORY_RAMFUNC void pipeline::decode(std::size_t index, sample_block& block) noexcept
+    {
+        std::uint32_t const started = get_cycles();
+        channel const& current = channels_[index];
+
+        bool is_ok = true;
+        for (auto const& transfer : current.transfers) {
+            is_ok = is_ok && transfer->await_resume() == err::ok;
+        }
+
+        if (is_ok) {
+            measurement& decoded = block.measurements[index];
+            decoded.shunt_raw = decode_register(current.raw[0]);
+            decoded.shunt_voltage = static_cast<float32_t>(decoded.shunt_raw) * INA226_SHUNT_VOLTAGE_SCALE;
+            decoded.bus_voltage = static_cast<float32_t>(decode_register(current.raw[1])) * INA226_BUS_VOLTAGE_SCALE;
+            decoded.power = static_cast<float32_t>(decode_register(current.raw[2])) * current.power_scale;
+            decoded.current = static_cast<float32_t>(decode_register(current.raw[3])) * current.current_scale;
+            block.valid_mask = static_cast<std::uint8_t>(block.valid_mask | (1U << index));
+        } else {
+            ++stats_.errors;
+        }
+
+        record(stats_.decode, get_cycles() - started);
+    }
+
+    sample_block* pipeline::claim_block() noexcept
+    {
+        if (block_states_[write_index_] != block_state::free) {
+            return nullptr;
+        }
+
+        block_states_[write_index_] = block_state::filling;
+
+        sample_block& block = blocks_[write_index_];
+        block.sequence = sequence_++;
+        block.device_count = static_cast<std::uint8_t>(channel_count_);
+        block.valid_mask = 0U;
+
+        return &block;
+    }
+
+    void pipeline::publish_block(sample_block& block, std::uint32_t started, std::uint32_t busy_before) noexcept
+    {
+        std::uint32_t const latency = get_cycles() - started;
+        std::uint32_t const wire = bus_.get_busy_cycles() - busy_before;
+
+        record(stats_.transfer, wire);
+        stats_.wire_cycles += wire;
+        stats_.latency_cycles += latency;
+        if (latency > stats_.max_latency_cycles) {
+            stats_.max_latency_cycles = latency;
+        }
+        ++stats_.blocks;
+
+        block_states_[static_cast<std::size_t>(&block - blocks_.data())] = block_state::ready;
+        write_index_ = (write_index_ + 1U) % PIPELINE_BLOCK_COUNT;
+
+        if (interface_.block_ready != nullptr) {
+            interface_.block_ready(interface_.user);
+        }
+    }
+
+    std::uint32_t pipeline::get_cycles() const noexcept
+    {
+        return interface_.get_cycles != nullptr ? interface_.get_cycles(interface_.user) : 0U;
+    }
+
+    void pipeline::record(stage_stats& stage, std::uint32_t cycles) noexcept
+    {
+        stage.busy_cycles += cycles;
+        ++stage.runs;
+        if (cycles > stage.max_cycles) {
+            stage.max_cycles = cycles;
+        }
+    }
+
+} // namespace async
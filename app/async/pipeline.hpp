@@ -0,0 +1,143 @@
+#ifndef ASYNC_PIPELINE_HPP
+#define ASYNC_PIPELINE_HPP
+
+#include "executor.hpp"
+#include "i2c_transport.hpp"
+#include "ina226_device.hpp"
+#include "task.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace async {
+
+    struct measurement {
+        float32_t shunt_voltage;
+        float32_t bus_voltage;
+        float32_t current;
+        float32_t power;
+        // as read, for integer processing downstream
+        std::int16_t shunt_raw;
+    };
+
+    struct sample_block {
+        std::uint64_t timestamp_us;
+        std::uint32_t sequence;
+        // set by begin_block, e.g. a configuration epoch, so consumers can tell where the
+        // device settings changed within the stream
+        std::uint32_t tag;
+        std::uint8_t device_count;
+        // bit n set if device n was read without a bus error
+        std::uint8_t valid_mask;
+        // bit n set if device n had no new conversion; it was not read and is not valid either
+        std::uint8_t stale_mask;
+        std::array<measurement, PIPELINE_MAX_DEVICES> measurements;
+    };
+
+    struct pipeline_interface {
+        void* user;
+        // decides whether this tick produces a block, stamps and tags it, and marks the devices
+        // to leave out in the stale mask
+        bool (*begin_block)(void*, std::uint64_t*, std::uint32_t*, std::uint8_t*);
+        // a decoded block is waiting for the aggregate stage
+        void (*block_ready)(void*);
+        void (*aggregate)(void*, sample_block const&);
+        std::uint32_t (*get_cycles)(void*);
+    };
+
+    // three-stage acquisition: transfer (bus, interrupt driven), decode (executor) and
+    // aggregate (whoever calls aggregate()); device n is decoded while device n + 1 is still
+    // on the wire, and decoded blocks are double-buffered towards the aggregate stage
+    class pipeline {
+    public:
+        struct stage_stats {
+            std::uint64_t busy_cycles;
+            std::uint32_t runs;
+            std::uint32_t max_cycles;
+        };
+
+        struct stats {
+            stage_stats transfer;
+            stage_stats decode;
+            stage_stats aggregate;
+            // cycles between the first and the latest block start
+            std::uint64_t window_cycles;
+            // block start to hand-off, against the bus time the same blocks needed
+            std::uint64_t latency_cycles;
+            std::uint64_t wire_cycles;
+            std::uint32_t max_latency_cycles;
+            std::uint32_t blocks;
+            std::uint32_t dropped_blocks;
+            std::uint32_t errors;
+        };
+
+        pipeline(i2c_transport& bus, pipeline_interface const& interface) noexcept;
+
+        pipeline(pipeline const&) = delete;
+        pipeline& operator=(pipeline const&) = delete;
+
+        err add_device(ina226_device const& device, ina226_t const& driver) noexcept;
+
+        // the order the devices go on the bus in, every device exactly once; registration
+        // order until set, e.g. by ready time after a synchronized trigger
+        err set_read_order(std::uint8_t const* order, std::size_t count) noexcept;
+
+        // transfer and decode stages, one block per tick
+        task<void> run(event& tick) noexcept;
+
+        // aggregate stage, returns the number of blocks consumed
+        std::size_t aggregate() noexcept;
+
+        [[nodiscard]] stats get_stats() const noexcept;
+        void reset_stats() noexcept;
+
+        [[nodiscard]] static std::uint32_t get_utilization_ppm(stage_stats const& stage,
+                                                               std::uint64_t window_cycles) noexcept;
+
+    private:
+        static constexpr std::size_t REGISTER_COUNT = 4U;
+
+        struct channel {
+            std::uint8_t address;
+            float32_t current_scale;
+            float32_t power_scale;
+            std::uint8_t raw[REGISTER_COUNT][2];
+            std::array<std::optional<i2c_transfer>, REGISTER_COUNT> transfers;
+        };
+
+        enum struct block_state : std::uint8_t {
+            free,
+            filling,
+            ready,
+        };
+
+        void submit_transfers(std::uint8_t stale_mask) noexcept;
+        void decode(std::size_t index, sample_block& block) noexcept;
+        sample_block* claim_block() noexcept;
+        void publish_block(sample_block& block, std::uint32_t started, std::uint32_t busy_before) noexcept;
+
+        std::uint32_t get_cycles() const noexcept;
+        static void record(stage_stats& stage, std::uint32_t cycles) noexcept;
+
+        i2c_transport& bus_;
+        pipeline_interface interface_;
+
+        std::array<channel, PIPELINE_MAX_DEVICES> channels_{};
+        std::size_t channel_count_{0U};
+        std::array<std::uint8_t, PIPELINE_MAX_DEVICES> order_{};
+
+        std::array<sample_block, PIPELINE_BLOCK_COUNT> blocks_{};
+        std::array<block_state, PIPELINE_BLOCK_COUNT> block_states_{};
+        std::size_t write_index_{0U};
+        std::size_t read_index_{0U};
+        std::uint32_t sequence_{0U};
+
+        bool has_started_{false};
+        std::uint32_t last_start_cycles_{0U};
+        stats stats_{};
+    };
+
+} // namespace async
+
+#endif // ASYNC_PIPELINE_HPP
@@ -0,0 +1,195 @@
+#ifndef ASYNC_TASK_HPP
+#define ASYNC_TASK_HPP
+
+#include "frame_pool.hpp"
+#include <coroutine>
+#include <cstdlib>
+#include <optional>
+#include <utility>
+
+namespace async {
+
+    template <typename T = void>
+    class task;
+
+    namespace detail {
+
+        struct promise_base {
+            struct final_awaiter {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                // symmetric transfer back to whoever awaited the task, so chains of awaits do not
+                // grow the stack
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+                {
+                    auto continuation = handle.promise().continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept
+                {}
+            };
+
+            static void* operator new(std::size_t size) noexcept
+            {
+                return frame_pool().allocate(size);
+            }
+
+            static void operator delete(void* frame) noexcept
+            {
+                frame_pool().deallocate(frame);
+            }
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            final_awaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception() const noexcept
+            {
+                std::abort();
+            }
+
+            std::coroutine_handle<> continuation{};
+        };
+
+        template <typename T>
+        struct promise : promise_base {
+            task<T> get_return_object() noexcept;
+
+            static task<T> get_return_object_on_allocation_failure() noexcept
+            {
+                return {};
+            }
+
+            template <typename U>
+            void return_value(U&& value) noexcept
+            {
+                result.emplace(std::forward<U>(value));
+            }
+
+            std::optional<T> result{};
+        };
+
+        template <>
+        struct promise<void> : promise_base {
+            task<void> get_return_object() noexcept;
+
+            static task<void> get_return_object_on_allocation_failure() noexcept;
+
+            void return_void() const noexcept
+            {}
+        };
+
+    } // namespace detail
+
+    // lazily started coroutine with its frame in the frame pool; a task that failed to get a
+    // frame is not valid() and must not be awaited
+    template <typename T>
+    class [[nodiscard]] task {
+    public:
+        using promise_type = detail::promise<T>;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        task() noexcept = default;
+
+        explicit task(handle_type handle) noexcept : handle_{handle}
+        {}
+
+        task(task&& other) noexcept : handle_{std::exchange(other.handle_, {})}
+        {}
+
+        task& operator=(task&& other) noexcept
+        {
+            if (this != &other) {
+                reset();
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+
+        task(task const&) = delete;
+        task& operator=(task const&) = delete;
+
+        ~task() noexcept
+        {
+            reset();
+        }
+
+        [[nodiscard]] bool valid() const noexcept
+        {
+            return static_cast<bool>(handle_);
+        }
+
+        [[nodiscard]] bool done() const noexcept
+        {
+            return !handle_ || handle_.done();
+        }
+
+        [[nodiscard]] handle_type release() noexcept
+        {
+            return std::exchange(handle_, {});
+        }
+
+        bool await_ready() const noexcept
+        {
+            return done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+        {
+            handle_.promise().continuation = caller;
+            return handle_;
+        }
+
+        T await_resume() noexcept
+        {
+            if constexpr (!std::is_void_v<T>) {
+                return std::move(*handle_.promise().result);
+            }
+        }
+
+    private:
+        void reset() noexcept
+        {
+            if (handle_) {
+                handle_.destroy();
+                handle_ = {};
+            }
+        }
+
+        handle_type handle_{};
+    };
+
+    namespace detail {
+
+        template <typename T>
+        task<T> promise<T>::get_return_object() noexcept
+        {
+            return task<T>{std::coroutine_handle<promise<T>>::from_promise(*this)};
+        }
+
+        inline task<void> promise<void>::get_return_object() noexcept
+        {
+            return task<void>{std::coroutine_handle<promise<void>>::from_promise(*this)};
+        }
+
+        inline task<void> promise<void>::get_return_object_on_allocation_failure() noexcept
+        {
+            return {};
+        }
+
+    } // namespace detail
+
+} // namespace async
+
+#endif // ASYNC_TASK_HPP
@@ -0,0 +1,369 @@
+#include "bus_scheduler.h"
+#include <assert.h>
+#include <string.h>
+
+// Liu & Layland bound n * (2^(1/n) - 1) in ppm, indexed by channel count
+static uint32_t const bus_scheduler_rate_monotonic_bound_ppm[BUS_SCHEDULER_MAX_CHANNELS + 1U] = {
+    1000000U,
+    1000000U,
+    828427U,
+    779763U,
+    756828U,
+    743492U,
+    734772U,
+    728627U,
+    724062U,
+};
+
+static uint32_t bus_scheduler_get_cost_ns(bus_scheduler_config_t const* config,
+                                          bus_scheduler_channel_config_t const* channel_config)
+{
+    uint64_t bits = (uint64_t)channel_config->reads_per_sample * BUS_SCHEDULER_REG_READ_BITS;
+    uint64_t wire_ns = (bits * 1000000000ULL + config->bus_frequency_hz - 1U) /
+                       config->bus_frequency_hz;
+
+    return (uint32_t)(wire_ns +
+                      (uint64_t)channel_config->reads_per_sample * config->transaction_overhead_ns);
+}
+
+static uint32_t bus_scheduler_get_conversion_time_us(
+    bus_scheduler_channel_config_t const* channel_config)
+{
+    return ina226_get_conversion_time_us(channel_config->avg,
+                                         channel_config->vbus_ct,
+                                         channel_config->vsh_ct,
+                                         channel_config->mode);
+}
+
+static uint32_t bus_scheduler_get_bound_ppm(bus_scheduler_config_t const* config, size_t count)
+{
+    uint32_t bound = config->policy == BUS_SCHEDULER_POLICY_RATE_MONOTONIC
+                         ? bus_scheduler_rate_monotonic_bound_ppm[count]
+                         : BUS_SCHEDULER_UTILIZATION_FULL_PPM;
+
+    if (config->utilization_limit_ppm != 0U && config->utilization_limit_ppm < bound) {
+        bound = config->utilization_limit_ppm;
+    }
+
+    return bound;
+}
+
+static uint32_t bus_scheduler_get_utilization_ppm(uint32_t cost_ns, uint32_t period_us)
+{
+    return (uint32_t)(((uint64_t)cost_ns * 1000U + period_us - 1U) / period_us);
+}
+
+static bus_scheduler_err_t bus_scheduler_update_channel(bus_scheduler_config_t const* config,
+                                                        bus_scheduler_channel_t* channel)
+{
+    if (channel->config.rate_hz == 0U || channel->config.reads_per_sample == 0U) {
+        return BUS_SCHEDULER_ERR_RATE;
+    }
+
+    // above 1 MHz the period truncates to zero, which no conversion time can meet anyway
+    channel->period_us = 1000000U / channel->config.rate_hz;
+    if (channel->period_us == 0U ||
+        channel->period_us < bus_scheduler_get_conversion_time_us(&channel->config)) {
+        return BUS_SCHEDULER_ERR_RATE;
+    }
+
+    channel->cost_ns = bus_scheduler_get_cost_ns(config, &channel->config);
+    channel->utilization_ppm =
+        bus_scheduler_get_utilization_ppm(channel->cost_ns, channel->period_us);
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+// transactions are not preemptive, so every channel can additionally be blocked by the
+// longest transaction of any other channel within its shortest period
+static bus_scheduler_err_t bus_scheduler_check_admission(bus_scheduler_config_t const* config,
+                                                         bus_scheduler_channel_t const* channels,
+                                                         size_t index,
+                                                         bus_scheduler_channel_t const* candidate,
+                                                         uint32_t* utilization_ppm)
+{
+    uint64_t utilization = 0U;
+    uint32_t max_cost_ns = 0U;
+    uint32_t min_period_us = UINT32_MAX;
+    size_t count = 0U;
+
+    for (size_t i = 0U; i < BUS_SCHEDULER_MAX_CHANNELS; ++i) {
+        bus_scheduler_channel_t const* channel = (i == index) ? candidate : &channels[i];
+        if (channel == NULL || !channel->is_active) {
+            continue;
+        }
+
+        uint32_t cost_ns = bus_scheduler_get_cost_ns(config, &channel->config);
+        utilization += bus_scheduler_get_utilization_ppm(cost_ns, channel->period_us);
+        if (cost_ns > max_cost_ns) {
+            max_cost_ns = cost_ns;
+        }
+        if (channel->period_us < min_period_us) {
+            min_period_us = channel->period_us;
+        }
+        ++count;
+    }
+
+    if (count > 0U) {
+        uint64_t blocking = ((uint64_t)max_cost_ns * 1000U + min_period_us - 1U) / min_period_us;
+        if (utilization + blocking > bus_scheduler_get_bound_ppm(config, count)) {
+            return BUS_SCHEDULER_ERR_CAPACITY;
+        }
+    }
+
+    *utilization_ppm = (uint32_t)utilization;
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_initialize(bus_scheduler_t* scheduler,
+                                             bus_scheduler_config_t const* config)
+{
+    assert(scheduler && config);
+
+    if (config->bus_frequency_hz == 0U) {
+        return BUS_SCHEDULER_ERR_FAIL;
+    }
+
+    memset(scheduler, 0, sizeof(*scheduler));
+    memcpy(&scheduler->config, config, sizeof(*config));
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_deinitialize(bus_scheduler_t* scheduler)
+{
+    assert(scheduler);
+
+    memset(scheduler, 0, sizeof(*scheduler));
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_add_channel(bus_scheduler_t* scheduler,
+                                              bus_scheduler_channel_config_t const* config,
+                                              size_t* index)
+{
+    assert(scheduler && config && index);
+
+    size_t free_index = BUS_SCHEDULER_MAX_CHANNELS;
+    for (size_t i = 0U; i < BUS_SCHEDULER_MAX_CHANNELS; ++i) {
+        if (!scheduler->channels[i].is_active) {
+            free_index = i;
+            break;
+        }
+    }
+    if (free_index == BUS_SCHEDULER_MAX_CHANNELS) {
+        return BUS_SCHEDULER_ERR_FAIL;
+    }
+
+    bus_scheduler_channel_t channel = {};
+    memcpy(&channel.config, config, sizeof(*config));
+    channel.is_active = true;
+
+    bus_scheduler_err_t err = bus_scheduler_update_channel(&scheduler->config, &channel);
+    if (err != BUS_SCHEDULER_ERR_OK) {
+        return err;
+    }
+
+    uint32_t utilization_ppm = 0U;
+    err = bus_scheduler_check_admission(&scheduler->config,
+                                        scheduler->channels,
+                                        free_index,
+                                        &channel,
+                                        &utilization_ppm);
+    if (err != BUS_SCHEDULER_ERR_OK) {
+        return err;
+    }
+
+    channel.deadline_us = channel.period_us;
+    memcpy(&scheduler->channels[free_index], &channel, sizeof(channel));
+    scheduler->utilization_ppm = utilization_ppm;
+    *index = free_index;
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_remove_channel(bus_scheduler_t* scheduler, size_t index)
+{
+    assert(scheduler);
+
+    if (index >= BUS_SCHEDULER_MAX_CHANNELS || !scheduler->channels[index].is_active) {
+        return BUS_SCHEDULER_ERR_FAIL;
+    }
+
+    scheduler->utilization_ppm -= scheduler->channels[index].utilization_ppm;
+    memset(&scheduler->channels[index], 0, sizeof(scheduler->channels[index]));
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_set_channel_rate(bus_scheduler_t* scheduler,
+                                                   size_t index,
+                                                   uint32_t rate_hz)
+{
+    assert(scheduler);
+
+    if (index >= BUS_SCHEDULER_MAX_CHANNELS || !scheduler->channels[index].is_active) {
+        return BUS_SCHEDULER_ERR_FAIL;
+    }
+
+    bus_scheduler_channel_t channel = scheduler->channels[index];
+    channel.config.rate_hz = rate_hz;
+
+    bus_scheduler_err_t err = bus_scheduler_update_channel(&scheduler->config, &channel);
+    if (err != BUS_SCHEDULER_ERR_OK) {
+        return err;
+    }
+
+    uint32_t utilization_ppm = 0U;
+    err = bus_scheduler_check_admission(&scheduler->config,
+                                        scheduler->channels,
+                                        index,
+                                        &channel,
+                                        &utilization_ppm);
+    if (err != BUS_SCHEDULER_ERR_OK) {
+        return err;
+    }
+
+    channel.deadline_us = channel.release_us + channel.period_us;
+    scheduler->channels[index] = channel;
+    scheduler->utilization_ppm = utilization_ppm;
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_set_bus_frequency(bus_scheduler_t* scheduler,
+                                                    uint32_t bus_frequency_hz)
+{
+    assert(scheduler);
+
+    if (bus_frequency_hz == 0U) {
+        return BUS_SCHEDULER_ERR_FAIL;
+    }
+
+    bus_scheduler_config_t config = scheduler->config;
+    config.bus_frequency_hz = bus_frequency_hz;
+
+    uint32_t utilization_ppm = 0U;
+    bus_scheduler_err_t err = bus_scheduler_check_admission(&config,
+                                                            scheduler->channels,
+                                                            BUS_SCHEDULER_MAX_CHANNELS,
+                                                            NULL,
+                                                            &utilization_ppm);
+    if (err != BUS_SCHEDULER_ERR_OK) {
+        return err;
+    }
+
+    // recompute on copies so a failing channel leaves the scheduler untouched
+    bus_scheduler_channel_t channels[BUS_SCHEDULER_MAX_CHANNELS];
+    memcpy(channels, scheduler->channels, sizeof(channels));
+    for (size_t i = 0U; i < BUS_SCHEDULER_MAX_CHANNELS; ++i) {
+        if (channels[i].is_active) {
+            err = bus_scheduler_update_channel(&config, &channels[i]);
+            if (err != BUS_SCHEDULER_ERR_OK) {
+                return err;
+            }
+        }
+    }
+
+    scheduler->config = config;
+    memcpy(scheduler->channels, channels, sizeof(channels));
+    scheduler->utilization_ppm = utilization_ppm;
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_start(bus_scheduler_t* scheduler, uint64_t now_us)
+{
+    assert(scheduler);
+
+    for (size_t i = 0U; i < BUS_SCHEDULER_MAX_CHANNELS; ++i) {
+        bus_scheduler_channel_t* channel = &scheduler->channels[i];
+        if (!channel->is_active) {
+            continue;
+        }
+
+        channel->release_us = now_us;
+        channel->deadline_us = now_us + channel->period_us;
+        channel->missed_deadlines = 0U;
+        channel->skipped_periods = 0U;
+    }
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_get_next_channel(bus_scheduler_t const* scheduler,
+                                                   uint64_t now_us,
+                                                   size_t* index)
+{
+    assert(scheduler && index);
+
+    bus_scheduler_channel_t const* next = NULL;
+
+    for (size_t i = 0U; i < BUS_SCHEDULER_MAX_CHANNELS; ++i) {
+        bus_scheduler_channel_t const* channel = &scheduler->channels[i];
+        if (!channel->is_active || channel->release_us > now_us) {
+            continue;
+        }
+
+        if (next == NULL ||
+            (scheduler->config.policy == BUS_SCHEDULER_POLICY_RATE_MONOTONIC
+                 ? channel->period_us < next->period_us
+                 : channel->deadline_us < next->deadline_us)) {
+            next = channel;
+            *index = i;
+        }
+    }
+
+    return next ? BUS_SCHEDULER_ERR_OK : BUS_SCHEDULER_ERR_IDLE;
+}
+
+bus_scheduler_err_t bus_scheduler_complete_channel(bus_scheduler_t* scheduler,
+                                                   size_t index,
+                                                   uint64_t now_us)
+{
+    assert(scheduler);
+
+    if (index >= BUS_SCHEDULER_MAX_CHANNELS || !scheduler->channels[index].is_active) {
+        return BUS_SCHEDULER_ERR_FAIL;
+    }
+
+    bus_scheduler_channel_t* channel = &scheduler->channels[index];
+
+    if (now_us > channel->deadline_us) {
+        ++channel->missed_deadlines;
+    }
+
+    channel->release_us += channel->period_us;
+    if (channel->release_us + channel->period_us <= now_us) {
+        channel->skipped_periods +=
+            (uint32_t)((now_us - channel->release_us) / channel->period_us);
+        channel->release_us = now_us;
+    }
+    channel->deadline_us = channel->release_us + channel->period_us;
+
+    return BUS_SCHEDULER_ERR_OK;
+}
+
+bus_scheduler_err_t bus_scheduler_get_next_release(bus_scheduler_t const* scheduler,
+                                                   uint64_t* release_us)
+{
+    assert(scheduler && release_us);
+
+    bool is_found = false;
+
+    for (size_t i = 0U; i < BUS_SCHEDULER_MAX_CHANNELS; ++i) {
+        bus_scheduler_channel_t const* channel = &scheduler->channels[i];
+        if (!channel->is_active) {
+            continue;
+        }
+
+        if (!is_found || channel->release_us < *release_us) {
+            *release_us = channel->release_us;
+            is_found = true;
+        }
+    }
+
+    return is_found ? BUS_SCHEDULER_ERR_OK : BUS_SCHEDULER_ERR_IDLE;
+}
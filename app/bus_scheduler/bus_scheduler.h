@@ -0,0 +1,57 @@
+#ifndef BUS_SCHEDULER_BUS_SCHEDULER_H
+#define BUS_SCHEDULER_BUS_SCHEDULER_H
+
+#include "bus_scheduler_config.h"
+#include <stdbool.h>
+
+typedef struct {
+    bus_scheduler_channel_config_t config;
+    bool is_active;
+    uint32_t period_us;
+    uint32_t cost_ns;
+    uint32_t utilization_ppm;
+    uint64_t release_us;
+    uint64_t deadline_us;
+    uint32_t missed_deadlines;
+    uint32_t skipped_periods;
+} bus_scheduler_channel_t;
+
+typedef struct {
+    bus_scheduler_config_t config;
+    bus_scheduler_channel_t channels[BUS_SCHEDULER_MAX_CHANNELS];
+    uint32_t utilization_ppm;
+} bus_scheduler_t;
+
+bus_scheduler_err_t bus_scheduler_initialize(bus_scheduler_t* scheduler,
+                                             bus_scheduler_config_t const* config);
+bus_scheduler_err_t bus_scheduler_deinitialize(bus_scheduler_t* scheduler);
+
+// admission control: rejects the channel if the bus cannot carry it at the current speed
+// (BUS_SCHEDULER_ERR_CAPACITY) or if it asks for samples faster than the conversion rate
+// (BUS_SCHEDULER_ERR_RATE)
+bus_scheduler_err_t bus_scheduler_add_channel(bus_scheduler_t* scheduler,
+                                              bus_scheduler_channel_config_t const* config,
+                                              size_t* index);
+bus_scheduler_err_t bus_scheduler_remove_channel(bus_scheduler_t* scheduler, size_t index);
+
+bus_scheduler_err_t bus_scheduler_set_channel_rate(bus_scheduler_t* scheduler,
+                                                   size_t index,
+                                                   uint32_t rate_hz);
+bus_scheduler_err_t bus_scheduler_set_bus_frequency(bus_scheduler_t* scheduler,
+                                                    uint32_t bus_frequency_hz);
+
+bus_scheduler_err_t bus_scheduler_start(bus_scheduler_t* scheduler, uint64_t now_us);
+
+// picks the released channel with the highest priority (shortest period for rate-monotonic,
+// earliest deadline for EDF), BUS_SCHEDULER_ERR_IDLE if none is released yet
+bus_scheduler_err_t bus_scheduler_get_next_channel(bus_scheduler_t const* scheduler,
+                                                   uint64_t now_us,
+                                                   size_t* index);
+bus_scheduler_err_t bus_scheduler_complete_channel(bus_scheduler_t* scheduler,
+                                                   size_t index,
+                                                   uint64_t now_us);
+
+bus_scheduler_err_t bus_scheduler_get_next_release(bus_scheduler_t const* scheduler,
+                                                   uint64_t* release_us);
+
+#endif // BUS_SCHEDULER_BUS_SCHEDULER_H
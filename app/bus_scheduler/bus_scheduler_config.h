@@ -0,0 +1,48 @@
+#ifndef BUS_SCHEDULER_BUS_SCHEDULER_CONFIG_H
+#define BUS_SCHEDULER_BUS_SCHEDULER_CONFIG_H
+
+#include "ina226.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define BUS_SCHEDULER_MAX_CHANNELS 8U
+
+// register read: S + addr/W + pointer + Sr + addr/R + 2 data bytes + P
+#define BUS_SCHEDULER_REG_READ_BITS 48U
+// register write: S + addr/W + pointer + 2 data bytes + P
+#define BUS_SCHEDULER_REG_WRITE_BITS 38U
+
+#define BUS_SCHEDULER_UTILIZATION_FULL_PPM 1000000U
+
+typedef enum {
+    BUS_SCHEDULER_ERR_OK = 0,
+    BUS_SCHEDULER_ERR_FAIL = 1 << 0,
+    BUS_SCHEDULER_ERR_NULL = 1 << 1,
+    BUS_SCHEDULER_ERR_CAPACITY = 1 << 2,
+    BUS_SCHEDULER_ERR_RATE = 1 << 3,
+    BUS_SCHEDULER_ERR_IDLE = 1 << 4,
+} bus_scheduler_err_t;
+
+typedef enum {
+    BUS_SCHEDULER_POLICY_RATE_MONOTONIC,
+    BUS_SCHEDULER_POLICY_EARLIEST_DEADLINE_FIRST,
+} bus_scheduler_policy_t;
+
+typedef struct {
+    bus_scheduler_policy_t policy;
+    uint32_t bus_frequency_hz;
+    uint32_t transaction_overhead_ns;
+    uint32_t utilization_limit_ppm;
+} bus_scheduler_config_t;
+
+typedef struct {
+    ina226_t* ina226;
+    uint32_t rate_hz;
+    uint8_t reads_per_sample;
+    ina226_avg_t avg;
+    ina226_vbus_ct_t vbus_ct;
+    ina226_vsh_ct_t vsh_ct;
+    ina226_mode_t mode;
+} bus_scheduler_channel_config_t;
+
+#endif // BUS_SCHEDULER_BUS_SCHEDULER_CONFIG_H
@@ -0,0 +1,150 @@
+#include "capture.h"
+#include <assert.h>
+#include <string.h>
+
+static void capture_start_window(capture_t* capture, capture_source_t source, uint64_t timestamp_us)
+{
+    capture->state = CAPTURE_STATE_TRIGGERED;
+    capture->source = source;
+    capture->trigger_us = timestamp_us;
+    capture->post_remaining = capture->config.post_samples;
+    capture->is_trigger_pending = false;
+}
+
+capture_err_t capture_initialize(capture_t* capture, capture_config_t const* config)
+{
+    assert(capture && config);
+
+    if (config->post_samples == 0U || config->pre_samples + config->post_samples > CAPTURE_MAX_SAMPLES) {
+        return CAPTURE_ERR_FAIL;
+    }
+
+    memset(capture, 0, sizeof(*capture));
+    memcpy(&capture->config, config, sizeof(*config));
+
+    capture->window = config->pre_samples + config->post_samples;
+    capture->state = CAPTURE_STATE_IDLE;
+
+    return CAPTURE_ERR_OK;
+}
+
+capture_err_t capture_deinitialize(capture_t* capture)
+{
+    assert(capture);
+
+    memset(capture, 0, sizeof(*capture));
+
+    return CAPTURE_ERR_OK;
+}
+
+capture_err_t capture_arm(capture_t* capture)
+{
+    assert(capture);
+
+    capture->state = CAPTURE_STATE_ARMED;
+    capture->head = 0U;
+    capture->pre_count = 0U;
+    capture->post_remaining = 0U;
+    capture->is_trigger_pending = false;
+    capture->source = CAPTURE_SOURCE_NONE;
+
+    return CAPTURE_ERR_OK;
+}
+
+capture_err_t capture_disarm(capture_t* capture)
+{
+    assert(capture);
+
+    capture->state = CAPTURE_STATE_IDLE;
+    capture->is_trigger_pending = false;
+
+    return CAPTURE_ERR_OK;
+}
+
+capture_err_t capture_push(capture_t* capture, int16_t sample, uint64_t timestamp_us)
+{
+    assert(capture);
+
+    if (capture->state == CAPTURE_STATE_ARMED) {
+        if (capture->is_trigger_pending) {
+            capture_start_window(capture, capture->pending_source, timestamp_us);
+        } else if (capture->config.is_threshold_enabled && sample >= capture->config.threshold) {
+            capture_start_window(capture, CAPTURE_SOURCE_THRESHOLD, timestamp_us);
+        }
+    }
+
+    switch (capture->state) {
+        case CAPTURE_STATE_ARMED:
+            capture->samples[capture->head] = sample;
+            capture->head = (capture->head + 1U) % capture->window;
+            if (capture->pre_count < capture->config.pre_samples) {
+                ++capture->pre_count;
+            }
+            return CAPTURE_ERR_OK;
+        case CAPTURE_STATE_TRIGGERED:
+            capture->samples[capture->head] = sample;
+            capture->head = (capture->head + 1U) % capture->window;
+            if (--capture->post_remaining == 0U) {
+                capture->state = CAPTURE_STATE_FROZEN;
+                ++capture->sequence;
+                ++capture->captures;
+            }
+            return CAPTURE_ERR_OK;
+        default:
+            return CAPTURE_ERR_OK;
+    }
+}
+
+capture_err_t capture_trigger(capture_t* capture, capture_source_t source)
+{
+    assert(capture);
+
+    if (capture->state != CAPTURE_STATE_ARMED || capture->is_trigger_pending) {
+        if (capture->state != CAPTURE_STATE_IDLE) {
+            ++capture->missed_triggers;
+        }
+        return CAPTURE_ERR_BUSY;
+    }
+
+    capture->is_trigger_pending = true;
+    capture->pending_source = source;
+
+    return CAPTURE_ERR_OK;
+}
+
+bool capture_is_frozen(capture_t const* capture)
+{
+    assert(capture);
+
+    return capture->state == CAPTURE_STATE_FROZEN;
+}
+
+size_t capture_get_count(capture_t const* capture)
+{
+    assert(capture);
+
+    return capture->state == CAPTURE_STATE_FROZEN ? capture->pre_count + capture->config.post_samples : 0U;
+}
+
+size_t capture_read(capture_t const* capture, size_t offset, int16_t* samples, size_t count)
+{
+    assert(capture);
+    assert(samples || count == 0U);
+
+    size_t const total = capture_get_count(capture);
+    if (offset >= total) {
+        return 0U;
+    }
+    if (count > total - offset) {
+        count = total - offset;
+    }
+
+    // the window ends right before head
+    size_t index = (capture->head + capture->window - total + offset) % capture->window;
+    for (size_t i = 0U; i < count; ++i) {
+        samples[i] = capture->samples[index];
+        index = index + 1U == capture->window ? 0U : index + 1U;
+    }
+
+    return count;
+}
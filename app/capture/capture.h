@@ -0,0 +1,50 @@
+#ifndef CAPTURE_CAPTURE_H
+#define CAPTURE_CAPTURE_H
+
+#include "capture_config.h"
+
+typedef struct {
+    capture_config_t config;
+    capture_state_t state;
+
+    // ring of pre_samples + post_samples; the post-trigger samples overwrite exactly the
+    // slots that fell out of the pre-trigger window
+    int16_t samples[CAPTURE_MAX_SAMPLES];
+    size_t window;
+    size_t head;
+    size_t pre_count;
+    size_t post_remaining;
+
+    // an external trigger makes the next pushed sample the trigger sample
+    bool is_trigger_pending;
+    capture_source_t pending_source;
+
+    // describes the frozen window
+    uint32_t sequence;
+    capture_source_t source;
+    uint64_t trigger_us;
+
+    uint32_t captures;
+    // triggers that came while a window was being taken or waiting to be read
+    uint32_t missed_triggers;
+} capture_t;
+
+capture_err_t capture_initialize(capture_t* capture, capture_config_t const* config);
+capture_err_t capture_deinitialize(capture_t* capture);
+
+// starts over with an empty pre-trigger window, dropping a frozen one
+capture_err_t capture_arm(capture_t* capture);
+capture_err_t capture_disarm(capture_t* capture);
+
+// feeds one raw sample, may trigger and freeze the window
+capture_err_t capture_push(capture_t* capture, int16_t sample, uint64_t timestamp_us);
+// e.g. from the ALERT pin; not for interrupt context, the caller forwards it from there
+capture_err_t capture_trigger(capture_t* capture, capture_source_t source);
+
+bool capture_is_frozen(capture_t const* capture);
+// pre-trigger samples first, the trigger sample is at index pre_count
+size_t capture_get_count(capture_t const* capture);
+// copies frozen samples in time order starting at offset, returns how many
+size_t capture_read(capture_t const* capture, size_t offset, int16_t* samples, size_t count);
+
+#endif // CAPTURE_CAPTURE_H
@@ -0,0 +1,44 @@
+#ifndef CAPTURE_CAPTURE_CONFIG_H
+#define CAPTURE_CAPTURE_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// pre- and post-trigger samples together
+#define CAPTURE_MAX_SAMPLES 1024U
+
+typedef enum {
+    CAPTURE_ERR_OK = 0,
+    CAPTURE_ERR_FAIL = 1 << 0,
+    CAPTURE_ERR_NULL = 1 << 1,
+    CAPTURE_ERR_BUSY = 1 << 2,
+} capture_err_t;
+
+typedef enum {
+    // nothing is recorded until capture_arm
+    CAPTURE_STATE_IDLE,
+    // the ring keeps the latest pre_samples, waiting for a trigger
+    CAPTURE_STATE_ARMED,
+    // taking the post-trigger samples
+    CAPTURE_STATE_TRIGGERED,
+    // the window is complete and stays as it is until capture_arm
+    CAPTURE_STATE_FROZEN,
+} capture_state_t;
+
+typedef enum {
+    CAPTURE_SOURCE_NONE,
+    CAPTURE_SOURCE_THRESHOLD,
+    CAPTURE_SOURCE_ALERT,
+} capture_source_t;
+
+typedef struct {
+    size_t pre_samples;
+    size_t post_samples;
+    // software trigger on the first sample at or above threshold, compared the way the
+    // SOL comparator does, so both can share one limit
+    bool is_threshold_enabled;
+    int16_t threshold;
+} capture_config_t;
+
+#endif // CAPTURE_CAPTURE_CONFIG_H
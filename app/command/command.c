@@ -0,0 +1,367 @@
+#include "command.h"
+#include <assert.h>
+#include <string.h>
+
+static bool command_is_config_op(uint8_t op)
+{
+    return op == COMMAND_OP_SET_AVERAGING || op == COMMAND_OP_SET_BUS_CONVERSION_TIME ||
+           op == COMMAND_OP_SET_SHUNT_CONVERSION_TIME || op == COMMAND_OP_SET_MODE;
+}
+
+static bool command_is_readable_reg(uint16_t address)
+{
+    return address <= INA226_REG_ADDRESS_ALERT_LIMIT ||
+           address == INA226_REG_ADDRESS_MANUFACTURER_ID || address == INA226_REG_ADDRESS_DIE_ID;
+}
+
+static bool command_cobs_decode(uint8_t const* in, size_t size, uint8_t* out, size_t out_capacity, size_t* out_size)
+{
+    size_t index = 0U;
+    size_t used = 0U;
+
+    while (index < size) {
+        uint8_t const code = in[index++];
+
+        if (code == 0U || index + code - 1U > size || used + code - 1U > out_capacity) {
+            return false;
+        }
+
+        memcpy(&out[used], &in[index], code - 1U);
+        used += code - 1U;
+        index += code - 1U;
+
+        // a full block carries no implicit zero, neither does the end of the frame
+        if (code != 0xFFU && index < size) {
+            if (used == out_capacity) {
+                return false;
+            }
+            out[used++] = 0U;
+        }
+    }
+
+    *out_size = used;
+
+    return true;
+}
+
+static uint32_t command_make_op_word(command_entry_t const* entry, command_status_t status, uint16_t result)
+{
+    return (uint32_t)result | ((uint32_t)status << 16U) | ((uint32_t)entry->op << 24U);
+}
+
+static void command_respond(command_t const* command,
+                            uint8_t sequence,
+                            command_status_t status,
+                            command_request_t const* request,
+                            command_status_t const* statuses,
+                            uint16_t const* results)
+{
+    if (!command->interface.respond) {
+        return;
+    }
+
+    uint32_t words[COMMAND_MAX_RESPONSE_WORDS];
+    size_t const count = request ? request->entry_count : 0U;
+
+    words[0] = (uint32_t)sequence | ((uint32_t)status << 8U) | ((uint32_t)count << 16U);
+    for (size_t i = 0U; i < count; ++i) {
+        words[1U + i] = command_make_op_word(&request->entries[i], statuses[i], results ? results[i] : 0U);
+    }
+
+    command->interface.respond(command->interface.user, words, 1U + count);
+}
+
+static command_status_t command_validate_entry(command_t const* command, command_entry_t const* entry)
+{
+    if (entry->op >= COMMAND_APP_OP_FIRST) {
+        return command->interface.app_op ? COMMAND_STATUS_OK : COMMAND_STATUS_BAD_OP;
+    }
+
+    if (entry->device >= command->device_count) {
+        return COMMAND_STATUS_BAD_DEVICE;
+    }
+
+    switch (entry->op) {
+        case COMMAND_OP_SET_AVERAGING:
+        case COMMAND_OP_SET_BUS_CONVERSION_TIME:
+        case COMMAND_OP_SET_SHUNT_CONVERSION_TIME:
+            return entry->value <= 0x07U ? COMMAND_STATUS_OK : COMMAND_STATUS_BAD_VALUE;
+        case COMMAND_OP_SET_MODE:
+            // 0b100 is a second power-down encoding, only the named modes are accepted
+            return entry->value <= 0x07U && entry->value != 0x04U ? COMMAND_STATUS_OK
+                                                                  : COMMAND_STATUS_BAD_VALUE;
+        case COMMAND_OP_SET_CALIBRATION:
+            return entry->value <= 0x7FFFU ? COMMAND_STATUS_OK : COMMAND_STATUS_BAD_VALUE;
+        case COMMAND_OP_SET_MASK_ENABLE:
+            return (entry->value & ~INA226_MASK_ENABLE_WRITABLE) == 0U ? COMMAND_STATUS_OK
+                                                                       : COMMAND_STATUS_BAD_VALUE;
+        case COMMAND_OP_SET_ALERT_LIMIT:
+            return COMMAND_STATUS_OK;
+        case COMMAND_OP_READ_REGISTER:
+            return command_is_readable_reg(entry->value) ? COMMAND_STATUS_OK : COMMAND_STATUS_BAD_VALUE;
+        default:
+            return COMMAND_STATUS_BAD_OP;
+    }
+}
+
+static void command_merge_config_op(ina226_config_reg_t* reg, command_entry_t const* entry)
+{
+    switch (entry->op) {
+        case COMMAND_OP_SET_AVERAGING:
+            reg->avg = entry->value & 0x07U;
+            break;
+        case COMMAND_OP_SET_BUS_CONVERSION_TIME:
+            reg->vbus_ct = entry->value & 0x07U;
+            break;
+        case COMMAND_OP_SET_SHUNT_CONVERSION_TIME:
+            reg->vsh_ct = entry->value & 0x07U;
+            break;
+        case COMMAND_OP_SET_MODE:
+            reg->mode = entry->value & 0x07U;
+            break;
+        default:
+            break;
+    }
+}
+
+static command_status_t command_apply_entry(command_t const* command, command_entry_t const* entry, uint16_t* result)
+{
+    if (entry->op >= COMMAND_APP_OP_FIRST) {
+        return command->interface.app_op(command->interface.user, entry->op, entry->value, result);
+    }
+
+    ina226_t* ina226 = command->devices[entry->device];
+    ina226_err_t err = INA226_ERR_OK;
+
+    *result = entry->value;
+
+    switch (entry->op) {
+        case COMMAND_OP_SET_CALIBRATION: {
+            ina226_calibration_reg_t const reg = {.fs = (uint16_t)(entry->value & 0x7FFFU)};
+            err = ina226_set_calibration_reg(ina226, &reg);
+            break;
+        }
+        case COMMAND_OP_SET_MASK_ENABLE: {
+            uint16_t const value = entry->value;
+            ina226_mask_enable_reg_t const reg = {.sol = (value >> 15U) & 0x01U,
+                                                  .sul = (value >> 14U) & 0x01U,
+                                                  .bol = (value >> 13U) & 0x01U,
+                                                  .bul = (value >> 12U) & 0x01U,
+                                                  .pol = (value >> 11U) & 0x01U,
+                                                  .cnvr = (value >> 10U) & 0x01U,
+                                                  .aff = (value >> 4U) & 0x01U,
+                                                  .cvrf = (value >> 3U) & 0x01U,
+                                                  .ovf = (value >> 2U) & 0x01U,
+                                                  .apol = (value >> 1U) & 0x01U,
+                                                  .len = value & 0x01U};
+            err = ina226_set_mask_enable_reg(ina226, &reg);
+            break;
+        }
+        case COMMAND_OP_SET_ALERT_LIMIT: {
+            ina226_alert_limit_reg_t const reg = {.aul = (int16_t)entry->value};
+            err = ina226_set_alert_limit_reg(ina226, &reg);
+            break;
+        }
+        case COMMAND_OP_READ_REGISTER:
+            err = ina226_get_reg_raw(ina226, (ina226_reg_address_t)entry->value, result);
+            break;
+        default:
+            return COMMAND_STATUS_BAD_OP;
+    }
+
+    return err == INA226_ERR_OK ? COMMAND_STATUS_OK : COMMAND_STATUS_BUS_FAIL;
+}
+
+static void command_handle_frame(command_t* command)
+{
+    uint8_t data[COMMAND_MAX_REQUEST_SIZE];
+    size_t size = 0U;
+
+    if (command->is_frame_overflow ||
+        !command_cobs_decode(command->frame, command->frame_size, data, sizeof(data), &size) ||
+        size < COMMAND_HEADER_SIZE || data[1] == 0U || data[1] > COMMAND_MAX_OPS ||
+        size != COMMAND_HEADER_SIZE + (size_t)data[1] * COMMAND_ENTRY_SIZE) {
+        ++command->rejected;
+        command_respond(command, size > 0U ? data[0] : 0U, COMMAND_STATUS_BAD_FRAME, NULL, NULL, NULL);
+        return;
+    }
+
+    if (command->has_pending) {
+        ++command->rejected;
+        command_respond(command, data[0], COMMAND_STATUS_BUSY, NULL, NULL, NULL);
+        return;
+    }
+
+    command_request_t request = {.sequence = data[0], .entry_count = data[1]};
+    command_status_t statuses[COMMAND_MAX_OPS];
+    command_status_t status = COMMAND_STATUS_OK;
+
+    for (size_t i = 0U; i < request.entry_count; ++i) {
+        uint8_t const* entry = &data[COMMAND_HEADER_SIZE + i * COMMAND_ENTRY_SIZE];
+
+        request.entries[i].device = entry[0];
+        request.entries[i].op = entry[1];
+        request.entries[i].value = (uint16_t)(entry[2] | (entry[3] << 8U));
+
+        statuses[i] = command_validate_entry(command, &request.entries[i]);
+        if (status == COMMAND_STATUS_OK) {
+            status = statuses[i];
+        }
+    }
+
+    // nothing is applied unless every op is valid
+    if (status != COMMAND_STATUS_OK) {
+        for (size_t i = 0U; i < request.entry_count; ++i) {
+            if (statuses[i] == COMMAND_STATUS_OK) {
+                statuses[i] = COMMAND_STATUS_NOT_APPLIED;
+            }
+        }
+
+        ++command->rejected;
+        command_respond(command, request.sequence, status, &request, statuses, NULL);
+        return;
+    }
+
+    command->pending = request;
+    command->has_pending = true;
+}
+
+command_err_t command_initialize(command_t* command, command_interface_t const* interface)
+{
+    assert(command && interface);
+
+    memset(command, 0, sizeof(*command));
+    memcpy(&command->interface, interface, sizeof(*interface));
+
+    return COMMAND_ERR_OK;
+}
+
+command_err_t command_deinitialize(command_t* command)
+{
+    assert(command);
+
+    memset(command, 0, sizeof(*command));
+
+    return COMMAND_ERR_OK;
+}
+
+command_err_t command_register_device(command_t* command, ina226_t* ina226, size_t* index)
+{
+    assert(command && ina226 && index);
+
+    if (command->device_count >= COMMAND_MAX_DEVICES) {
+        return COMMAND_ERR_FAIL;
+    }
+
+    *index = command->device_count;
+    command->devices[command->device_count++] = ina226;
+
+    return COMMAND_ERR_OK;
+}
+
+command_err_t command_receive(command_t* command, uint8_t const* data, size_t size)
+{
+    assert(command && data);
+
+    for (size_t i = 0U; i < size; ++i) {
+        if (data[i] != 0U) {
+            if (command->frame_size < COMMAND_MAX_FRAME_SIZE) {
+                command->frame[command->frame_size++] = data[i];
+            } else {
+                command->is_frame_overflow = true;
+            }
+            continue;
+        }
+
+        // back-to-back delimiters are how a host resynchronizes, not an empty request
+        if (command->frame_size > 0U || command->is_frame_overflow) {
+            command_handle_frame(command);
+        }
+
+        command->frame_size = 0U;
+        command->is_frame_overflow = false;
+    }
+
+    return COMMAND_ERR_OK;
+}
+
+bool command_has_pending(command_t const* command)
+{
+    assert(command);
+
+    return command->has_pending;
+}
+
+command_err_t command_apply_pending(command_t* command)
+{
+    assert(command);
+
+    if (!command->has_pending) {
+        return COMMAND_ERR_OK;
+    }
+
+    command_request_t const* request = &command->pending;
+    command_status_t statuses[COMMAND_MAX_OPS];
+    uint16_t results[COMMAND_MAX_OPS];
+
+    // CONFIG fields of all ops are folded into the driver's shadow first, so every device
+    // sees one write and one conversion restart however many fields changed
+    ina226_config_reg_t configs[COMMAND_MAX_DEVICES];
+    bool is_config_dirty[COMMAND_MAX_DEVICES] = {};
+    command_status_t config_statuses[COMMAND_MAX_DEVICES];
+
+    for (size_t i = 0U; i < request->entry_count; ++i) {
+        command_entry_t const* entry = &request->entries[i];
+
+        if (command_is_config_op(entry->op)) {
+            if (!is_config_dirty[entry->device]) {
+                configs[entry->device] = command->devices[entry->device]->config_reg;
+                configs[entry->device].rst = 0U;
+                is_config_dirty[entry->device] = true;
+            }
+            command_merge_config_op(&configs[entry->device], entry);
+            results[i] = entry->value;
+        }
+    }
+
+    command_status_t status = COMMAND_STATUS_OK;
+
+    for (size_t i = 0U; i < command->device_count; ++i) {
+        if (!is_config_dirty[i]) {
+            continue;
+        }
+
+        config_statuses[i] = ina226_set_config_reg(command->devices[i], &configs[i]) == INA226_ERR_OK
+                                 ? COMMAND_STATUS_OK
+                                 : COMMAND_STATUS_BUS_FAIL;
+        if (status == COMMAND_STATUS_OK) {
+            status = config_statuses[i];
+        }
+    }
+
+    // the remaining ops run in request order and stop at the first failure, which is what
+    // the NOT_APPLIED entries after it tell the host
+    for (size_t i = 0U; i < request->entry_count; ++i) {
+        command_entry_t const* entry = &request->entries[i];
+
+        if (command_is_config_op(entry->op)) {
+            statuses[i] = config_statuses[entry->device];
+            continue;
+        }
+
+        results[i] = 0U;
+        if (status != COMMAND_STATUS_OK) {
+            statuses[i] = COMMAND_STATUS_NOT_APPLIED;
+            continue;
+        }
+
+        statuses[i] = command_apply_entry(command, entry, &results[i]);
+        status = statuses[i];
+    }
+
+    ++command->requests;
+    command->has_pending = false;
+    command_respond(command, request->sequence, status, request, statuses, results);
+
+    return status == COMMAND_STATUS_OK ? COMMAND_ERR_OK : COMMAND_ERR_FAIL;
+}
@@ -0,0 +1,39 @@
+#ifndef COMMAND_COMMAND_H
+#define COMMAND_COMMAND_H
+
+#include "command_config.h"
+#include "ina226.h"
+
+typedef struct {
+    command_interface_t interface;
+
+    ina226_t* devices[COMMAND_MAX_DEVICES];
+    size_t device_count;
+
+    uint8_t frame[COMMAND_MAX_FRAME_SIZE];
+    size_t frame_size;
+    bool is_frame_overflow;
+
+    command_request_t pending;
+    bool has_pending;
+
+    uint32_t requests;
+    uint32_t rejected;
+} command_t;
+
+command_err_t command_initialize(command_t* command, command_interface_t const* interface);
+command_err_t command_deinitialize(command_t* command);
+
+command_err_t command_register_device(command_t* command, ina226_t* ina226, size_t* index);
+
+// feeds received bytes; a complete frame is validated as a whole and either answered right
+// away with the reason it was rejected or held until command_apply_pending
+command_err_t command_receive(command_t* command, uint8_t const* data, size_t size);
+
+bool command_has_pending(command_t const* command);
+
+// applies the held request and answers it; call where the devices are not otherwise in use,
+// e.g. between two samples. CONFIG field ops are merged into a single write per device
+command_err_t command_apply_pending(command_t* command);
+
+#endif // COMMAND_COMMAND_H
@@ -0,0 +1,90 @@
+#ifndef COMMAND_COMMAND_CONFIG_H
+#define COMMAND_COMMAND_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define COMMAND_MAX_DEVICES 4U
+#define COMMAND_MAX_OPS 8U
+
+// request: u8 sequence, u8 op count, then per op u8 device, u8 op, u16 little-endian value
+#define COMMAND_HEADER_SIZE 2U
+#define COMMAND_ENTRY_SIZE 4U
+#define COMMAND_MAX_REQUEST_SIZE (COMMAND_HEADER_SIZE + COMMAND_MAX_OPS * COMMAND_ENTRY_SIZE)
+
+// COBS adds one byte per started 254, the zero delimiter is not stored
+#define COMMAND_MAX_FRAME_SIZE (COMMAND_MAX_REQUEST_SIZE + COMMAND_MAX_REQUEST_SIZE / 254U + 1U)
+
+// response: a header word, then one word per op
+#define COMMAND_MAX_RESPONSE_WORDS (1U + COMMAND_MAX_OPS)
+
+// ops from here on are not device registers and are handed to the interface
+#define COMMAND_APP_OP_FIRST 0x40U
+
+typedef enum {
+    COMMAND_ERR_OK = 0,
+    COMMAND_ERR_FAIL = 1 << 0,
+    COMMAND_ERR_NULL = 1 << 1,
+    COMMAND_ERR_BUSY = 1 << 2,
+} command_err_t;
+
+typedef enum {
+    COMMAND_STATUS_OK = 0x00,
+    COMMAND_STATUS_BAD_FRAME = 0x01,
+    COMMAND_STATUS_BAD_OP = 0x02,
+    COMMAND_STATUS_BAD_DEVICE = 0x03,
+    COMMAND_STATUS_BAD_VALUE = 0x04,
+    COMMAND_STATUS_BUSY = 0x05,
+    COMMAND_STATUS_BUS_FAIL = 0x06,
+    COMMAND_STATUS_NOT_APPLIED = 0x07,
+} command_status_t;
+
+typedef enum {
+    COMMAND_OP_SET_AVERAGING = 0x01,
+    COMMAND_OP_SET_BUS_CONVERSION_TIME = 0x02,
+    COMMAND_OP_SET_SHUNT_CONVERSION_TIME = 0x03,
+    COMMAND_OP_SET_MODE = 0x04,
+    COMMAND_OP_SET_CALIBRATION = 0x05,
+    COMMAND_OP_SET_MASK_ENABLE = 0x06,
+    COMMAND_OP_SET_ALERT_LIMIT = 0x07,
+    COMMAND_OP_READ_REGISTER = 0x08,
+    COMMAND_OP_TELEMETRY = 0x40,
+    COMMAND_OP_RESET_COUNTERS = 0x41,
+    COMMAND_OP_SET_PROFILE = 0x42,
+    COMMAND_OP_SET_BANDWIDTH = 0x43,
+    COMMAND_OP_SET_DECIMATION = 0x44,
+    COMMAND_OP_ARM_CAPTURE = 0x45,
+    COMMAND_OP_DISARM_CAPTURE = 0x46,
+    COMMAND_OP_SET_ALERT_LIMIT_LOW = 0x47,
+    COMMAND_OP_SET_ALERT_LIMIT_HIGH = 0x48,
+    COMMAND_OP_SET_ALERT = 0x49,
+    COMMAND_OP_SET_ALERT_HYSTERESIS = 0x4A,
+    COMMAND_OP_SET_TRANSIENT = 0x4B,
+    COMMAND_OP_ADD_SEGMENT_THRESHOLD = 0x4C,
+    COMMAND_OP_SET_SEGMENTER = 0x4D,
+    COMMAND_OP_DUMP_HISTOGRAM = 0x4E,
+    COMMAND_OP_SET_ACQUISITION_MODE = 0x4F,
+} command_op_t;
+
+typedef struct {
+    uint8_t device;
+    uint8_t op;
+    uint16_t value;
+} command_entry_t;
+
+typedef struct {
+    uint8_t sequence;
+    uint8_t entry_count;
+    command_entry_t entries[COMMAND_MAX_OPS];
+} command_request_t;
+
+typedef struct {
+    void* user;
+    // sends one response, called from command_receive and command_apply_pending
+    void (*respond)(void*, uint32_t const*, size_t);
+    // ops from COMMAND_APP_OP_FIRST, optional; result is echoed in the response
+    command_status_t (*app_op)(void*, uint8_t, uint16_t, uint16_t*);
+} command_interface_t;
+
+#endif // COMMAND_COMMAND_CONFIG_H
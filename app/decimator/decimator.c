@@ -0,0 +1,109 @@
+#include "decimator.h"
+#include <assert.h>
+#include <string.h>
+
+static uint32_t decimator_ceil_log2(uint32_t value)
+{
+    uint32_t bits = 0U;
+
+    while (bits < 32U && (1ULL << bits) < value) {
+        ++bits;
+    }
+
+    return bits;
+}
+
+decimator_err_t decimator_initialize(decimator_t* decimator, decimator_config_t const* config)
+{
+    assert(decimator && config);
+
+    if (config->order == 0U || config->order > DECIMATOR_MAX_ORDER || config->ratio == 0U) {
+        return DECIMATOR_ERR_FAIL;
+    }
+
+    uint32_t const full_bits = DECIMATOR_INPUT_BITS + config->order * decimator_ceil_log2(config->ratio);
+    if (full_bits > DECIMATOR_ACCUMULATOR_BITS) {
+        return DECIMATOR_ERR_FAIL;
+    }
+
+    memset(decimator, 0, sizeof(*decimator));
+    memcpy(&decimator->config, config, sizeof(*config));
+
+    decimator->full_bits = full_bits;
+    decimator->shift = full_bits > DECIMATOR_OUTPUT_BITS ? full_bits - DECIMATOR_OUTPUT_BITS : 0U;
+    decimator->gain = 1U;
+    for (uint32_t i = 0U; i < config->order; ++i) {
+        decimator->gain *= config->ratio;
+    }
+
+    return DECIMATOR_ERR_OK;
+}
+
+decimator_err_t decimator_deinitialize(decimator_t* decimator)
+{
+    assert(decimator);
+
+    memset(decimator, 0, sizeof(*decimator));
+
+    return DECIMATOR_ERR_OK;
+}
+
+decimator_err_t decimator_reset(decimator_t* decimator)
+{
+    assert(decimator);
+
+    memset(decimator->integrators, 0, sizeof(decimator->integrators));
+    memset(decimator->combs, 0, sizeof(decimator->combs));
+    decimator->phase = 0U;
+
+    return DECIMATOR_ERR_OK;
+}
+
+decimator_err_t decimator_process(decimator_t* decimator,
+                                  int16_t const* input,
+                                  size_t input_count,
+                                  int32_t* output,
+                                  size_t output_capacity,
+                                  size_t* output_count)
+{
+    assert(decimator && input && output_count);
+    assert(output || output_capacity == 0U);
+
+    decimator_err_t err = DECIMATOR_ERR_OK;
+    uint32_t const order = decimator->config.order;
+    size_t count = 0U;
+
+    for (size_t i = 0U; i < input_count; ++i) {
+        // unsigned, so the wrap-around the CIC relies on is well defined
+        uint64_t value = (uint64_t)(int64_t)input[i];
+
+        for (uint32_t k = 0U; k < order; ++k) {
+            decimator->integrators[k] += value;
+            value = decimator->integrators[k];
+        }
+
+        if (++decimator->phase < decimator->config.ratio) {
+            continue;
+        }
+        decimator->phase = 0U;
+
+        for (uint32_t k = 0U; k < order; ++k) {
+            uint64_t const previous = decimator->combs[k];
+            decimator->combs[k] = value;
+            value -= previous;
+        }
+
+        if (count == output_capacity) {
+            ++decimator->overruns;
+            err |= DECIMATOR_ERR_OVERRUN;
+            continue;
+        }
+
+        output[count++] = (int32_t)((int64_t)value >> decimator->shift);
+        ++decimator->outputs;
+    }
+
+    *output_count = count;
+
+    return err;
+}
@@ -0,0 +1,38 @@
+#ifndef DECIMATOR_DECIMATOR_H
+#define DECIMATOR_DECIMATOR_H
+
+#include "decimator_config.h"
+
+typedef struct {
+    decimator_config_t config;
+
+    uint64_t integrators[DECIMATOR_MAX_ORDER];
+    uint64_t combs[DECIMATOR_MAX_ORDER];
+    uint32_t phase;
+
+    // full-precision width, the right shift that brings it down to DECIMATOR_OUTPUT_BITS and
+    // the DC gain ratio^order; an output times 2^shift / gain is in input LSBs
+    uint32_t full_bits;
+    uint32_t shift;
+    uint64_t gain;
+
+    uint32_t outputs;
+    uint32_t overruns;
+} decimator_t;
+
+decimator_err_t decimator_initialize(decimator_t* decimator, decimator_config_t const* config);
+decimator_err_t decimator_deinitialize(decimator_t* decimator);
+
+// clears the filter state; the first order - 1 outputs after it are still settling
+decimator_err_t decimator_reset(decimator_t* decimator);
+
+// integer only; writes one output per ratio inputs, up to capacity, and reports an overrun
+// for outputs that did not fit
+decimator_err_t decimator_process(decimator_t* decimator,
+                                  int16_t const* input,
+                                  size_t input_count,
+                                  int32_t* output,
+                                  size_t output_capacity,
+                                  size_t* output_count);
+
+#endif // DECIMATOR_DECIMATOR_H
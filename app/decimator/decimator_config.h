@@ -0,0 +1,29 @@
+#ifndef DECIMATOR_DECIMATOR_CONFIG_H
+#define DECIMATOR_DECIMATOR_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DECIMATOR_MAX_ORDER 4U
+#define DECIMATOR_INPUT_BITS 16U
+// the integrators wrap modulo 2^64, which is harmless as long as the full-precision output
+// (input bits plus order * log2(ratio)) fits
+#define DECIMATOR_ACCUMULATOR_BITS 64U
+#define DECIMATOR_OUTPUT_BITS 32U
+
+typedef enum {
+    DECIMATOR_ERR_OK = 0,
+    DECIMATOR_ERR_FAIL = 1 << 0,
+    DECIMATOR_ERR_NULL = 1 << 1,
+    DECIMATOR_ERR_OVERRUN = 1 << 2,
+} decimator_err_t;
+
+typedef struct {
+    // 1 is a plain boxcar sum, higher orders trade a longer settling for better alias
+    // rejection (CIC, differential delay 1)
+    uint32_t order;
+    uint32_t ratio;
+} decimator_config_t;
+
+#endif // DECIMATOR_DECIMATOR_CONFIG_H
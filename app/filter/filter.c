@@ -0,0 +1,221 @@
+#include "filter.h"
+#include <assert.h>
+#include <string.h>
+
+// SMLALD does two 16x16 multiplies into a 64-bit accumulator per instruction on cores with
+// the DSP extension; everything else, host builds included, takes the plain C loop
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#define FILTER_DUAL_MAC 1
+#else
+#define FILTER_DUAL_MAC 0
+#endif
+
+static int16_t filter_saturate(int64_t value, uint32_t* saturations)
+{
+    if (value > INT16_MAX) {
+        ++*saturations;
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        ++*saturations;
+        return INT16_MIN;
+    }
+
+    return (int16_t)value;
+}
+
+static int16_t filter_negate(int16_t value)
+{
+    return value == INT16_MIN ? INT16_MAX : (int16_t)-value;
+}
+
+#if FILTER_DUAL_MAC
+static int16x2_t filter_load_pair(int16_t const* pair)
+{
+    // LDR handles unaligned addresses on the M4, memcpy keeps the compiler from assuming otherwise
+    int16x2_t value;
+    memcpy(&value, pair, sizeof(value));
+
+    return value;
+}
+
+static int16x2_t filter_pack_pair(int16_t low, int16_t high)
+{
+    return (int16x2_t)((uint32_t)(uint16_t)low | ((uint32_t)(uint16_t)high << 16U));
+}
+#endif
+
+static int64_t filter_dot(int16_t const* coefficients, int16_t const* samples, size_t taps)
+{
+    int64_t accumulator = 0;
+
+#if FILTER_DUAL_MAC
+    for (size_t k = 0U; k < taps; k += 2U) {
+        accumulator = __smlald(filter_load_pair(&coefficients[k]), filter_load_pair(&samples[k]), accumulator);
+    }
+#else
+    for (size_t k = 0U; k < taps; ++k) {
+        accumulator += (int32_t)coefficients[k] * (int32_t)samples[k];
+    }
+#endif
+
+    return accumulator;
+}
+
+static int16_t filter_biquad_step(int16_t const* coefficients, int16_t* state, int16_t input, uint32_t* saturations)
+{
+    int64_t accumulator = 1 << (FILTER_BIQUAD_COEFFICIENT_SHIFT - 1U);
+
+#if FILTER_DUAL_MAC
+    accumulator = __smlald(filter_load_pair(&coefficients[0]), filter_pack_pair(input, state[0]), accumulator);
+    accumulator = __smlald(filter_load_pair(&coefficients[2]), filter_load_pair(&state[1]), accumulator);
+    accumulator += (int32_t)coefficients[4] * (int32_t)state[3];
+#else
+    accumulator += (int32_t)coefficients[0] * (int32_t)input;
+    accumulator += (int32_t)coefficients[1] * (int32_t)state[0];
+    accumulator += (int32_t)coefficients[2] * (int32_t)state[1];
+    accumulator += (int32_t)coefficients[3] * (int32_t)state[2];
+    accumulator += (int32_t)coefficients[4] * (int32_t)state[3];
+#endif
+
+    int16_t const output = filter_saturate(accumulator >> FILTER_BIQUAD_COEFFICIENT_SHIFT, saturations);
+
+    state[1] = state[0];
+    state[0] = input;
+    state[3] = state[2];
+    state[2] = output;
+
+    return output;
+}
+
+filter_err_t filter_fir_initialize(filter_fir_t* fir, filter_fir_config_t const* config)
+{
+    assert(fir && config);
+
+    if (config->taps == 0U || config->taps > FILTER_FIR_MAX_TAPS) {
+        return FILTER_ERR_FAIL;
+    }
+
+    memset(fir, 0, sizeof(*fir));
+    memcpy(&fir->config, config, sizeof(*config));
+
+    // an odd filter gets a zero tap past its oldest one, which lands in front once reversed
+    fir->taps = (config->taps + 1U) & ~(size_t)1U;
+    size_t const padding = fir->taps - config->taps;
+    for (size_t k = 0U; k < config->taps; ++k) {
+        fir->coefficients[padding + k] = config->coefficients[config->taps - 1U - k];
+    }
+
+    return FILTER_ERR_OK;
+}
+
+filter_err_t filter_fir_deinitialize(filter_fir_t* fir)
+{
+    assert(fir);
+
+    memset(fir, 0, sizeof(*fir));
+
+    return FILTER_ERR_OK;
+}
+
+filter_err_t filter_fir_reset(filter_fir_t* fir)
+{
+    assert(fir);
+
+    memset(fir->history, 0, sizeof(fir->history));
+
+    return FILTER_ERR_OK;
+}
+
+filter_err_t filter_fir_process(filter_fir_t* fir, int16_t const* input, int16_t* output, size_t count)
+{
+    assert(fir);
+    assert((input && output) || count == 0U);
+
+    size_t const kept = fir->taps - 1U;
+
+    while (count > 0U) {
+        size_t const chunk = count < FILTER_FIR_CHUNK_SIZE ? count : FILTER_FIR_CHUNK_SIZE;
+
+        // the whole chunk goes into the history first, which is what makes in place safe
+        memcpy(&fir->history[kept], input, chunk * sizeof(*input));
+
+        for (size_t n = 0U; n < chunk; ++n) {
+            int64_t const accumulator = filter_dot(fir->coefficients, &fir->history[n], fir->taps) +
+                                        (1 << (FILTER_FIR_COEFFICIENT_SHIFT - 1U));
+            output[n] = filter_saturate(accumulator >> FILTER_FIR_COEFFICIENT_SHIFT, &fir->saturations);
+        }
+
+        memmove(fir->history, &fir->history[chunk], kept * sizeof(*fir->history));
+
+        input += chunk;
+        output += chunk;
+        count -= chunk;
+    }
+
+    return FILTER_ERR_OK;
+}
+
+filter_err_t filter_biquad_initialize(filter_biquad_t* biquad, filter_biquad_config_t const* config)
+{
+    assert(biquad && config);
+
+    if (config->section_count > FILTER_BIQUAD_MAX_SECTIONS) {
+        return FILTER_ERR_FAIL;
+    }
+
+    memset(biquad, 0, sizeof(*biquad));
+    memcpy(&biquad->config, config, sizeof(*config));
+
+    for (size_t i = 0U; i < config->section_count; ++i) {
+        filter_biquad_section_t const* section = &config->sections[i];
+
+        biquad->coefficients[i][0] = section->b0;
+        biquad->coefficients[i][1] = section->b1;
+        biquad->coefficients[i][2] = section->b2;
+        biquad->coefficients[i][3] = filter_negate(section->a1);
+        biquad->coefficients[i][4] = filter_negate(section->a2);
+    }
+
+    return FILTER_ERR_OK;
+}
+
+filter_err_t filter_biquad_deinitialize(filter_biquad_t* biquad)
+{
+    assert(biquad);
+
+    memset(biquad, 0, sizeof(*biquad));
+
+    return FILTER_ERR_OK;
+}
+
+filter_err_t filter_biquad_reset(filter_biquad_t* biquad)
+{
+    assert(biquad);
+
+    memset(biquad->state, 0, sizeof(biquad->state));
+
+    return FILTER_ERR_OK;
+}
+
+filter_err_t filter_biquad_process(filter_biquad_t* biquad, int16_t const* input, int16_t* output, size_t count)
+{
+    assert(biquad);
+    assert((input && output) || count == 0U);
+
+    if (output != input) {
+        memmove(output, input, count * sizeof(*input));
+    }
+
+    for (size_t i = 0U; i < biquad->config.section_count; ++i) {
+        int16_t const* coefficients = biquad->coefficients[i];
+        int16_t* state = biquad->state[i];
+
+        for (size_t n = 0U; n < count; ++n) {
+            output[n] = filter_biquad_step(coefficients, state, output[n], &biquad->saturations);
+        }
+    }
+
+    return FILTER_ERR_OK;
+}
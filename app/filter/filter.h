@@ -0,0 +1,45 @@
+#ifndef FILTER_FILTER_H
+#define FILTER_FILTER_H
+
+#include "filter_config.h"
+
+typedef struct {
+    filter_fir_config_t config;
+
+    // time-reversed and padded to an even count, so an output is a plain dot product of
+    // these with the oldest-first history
+    int16_t coefficients[FILTER_FIR_MAX_TAPS];
+    size_t taps;
+    int16_t history[FILTER_FIR_MAX_TAPS - 1U + FILTER_FIR_CHUNK_SIZE];
+
+    uint32_t saturations;
+} filter_fir_t;
+
+typedef struct {
+    filter_biquad_config_t config;
+
+    // per section b0, b1, b2, -a1, -a2, laid out so that the middle pair lines up with the
+    // x2, y1 pair of the state
+    int16_t coefficients[FILTER_BIQUAD_MAX_SECTIONS][5];
+    // per section x1, x2, y1, y2
+    int16_t state[FILTER_BIQUAD_MAX_SECTIONS][4];
+
+    uint32_t saturations;
+} filter_biquad_t;
+
+filter_err_t filter_fir_initialize(filter_fir_t* fir, filter_fir_config_t const* config);
+filter_err_t filter_fir_deinitialize(filter_fir_t* fir);
+filter_err_t filter_fir_reset(filter_fir_t* fir);
+
+// one output per input, may run in place; outputs saturate to int16 and are counted
+filter_err_t filter_fir_process(filter_fir_t* fir, int16_t const* input, int16_t* output, size_t count);
+
+filter_err_t filter_biquad_initialize(filter_biquad_t* biquad, filter_biquad_config_t const* config);
+filter_err_t filter_biquad_deinitialize(filter_biquad_t* biquad);
+filter_err_t filter_biquad_reset(filter_biquad_t* biquad);
+
+// runs the cascade section by section over the whole block, may run in place; every section
+// output saturates to int16, which is also what its direct form I state keeps
+filter_err_t filter_biquad_process(filter_biquad_t* biquad, int16_t const* input, int16_t* output, size_t count);
+
+#endif // FILTER_FILTER_H
@@ -0,0 +1,44 @@
+#ifndef FILTER_FILTER_CONFIG_H
+#define FILTER_FILTER_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// even, the dual-MAC loop takes two taps at a time and odd filters get a zero tap appended
+#define FILTER_FIR_MAX_TAPS 32U
+// longer inputs are processed in chunks of this many samples
+#define FILTER_FIR_CHUNK_SIZE 32U
+#define FILTER_FIR_COEFFICIENT_SHIFT 15U
+
+#define FILTER_BIQUAD_MAX_SECTIONS 4U
+// biquad coefficients are Q2.14, so that feedback terms up to +-2 are representable
+#define FILTER_BIQUAD_COEFFICIENT_SHIFT 14U
+
+typedef enum {
+    FILTER_ERR_OK = 0,
+    FILTER_ERR_FAIL = 1 << 0,
+    FILTER_ERR_NULL = 1 << 1,
+} filter_err_t;
+
+typedef struct {
+    // Q15, in the usual order: coefficients[0] weights the newest sample
+    int16_t coefficients[FILTER_FIR_MAX_TAPS];
+    size_t taps;
+} filter_fir_config_t;
+
+typedef struct {
+    // Q2.14, normalized to a0 = 1: y = b0 x0 + b1 x1 + b2 x2 - a1 y1 - a2 y2
+    int16_t b0;
+    int16_t b1;
+    int16_t b2;
+    int16_t a1;
+    int16_t a2;
+} filter_biquad_section_t;
+
+typedef struct {
+    filter_biquad_section_t sections[FILTER_BIQUAD_MAX_SECTIONS];
+    size_t section_count;
+} filter_biquad_config_t;
+
+#endif // FILTER_FILTER_CONFIG_H
@@ -0,0 +1,178 @@
+#include "histogram.h"
+#include <assert.h>
+#include <string.h>
+
+// one CLZ for the power of two, then the top SUB_BUCKET_BITS below the leading one
+static size_t histogram_magnitude_index(uint32_t magnitude)
+{
+    if (magnitude < HISTOGRAM_SUB_BUCKETS) {
+        return magnitude;
+    }
+
+    uint32_t const exponent = 31U - (uint32_t)__builtin_clz(magnitude);
+    uint32_t const shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+
+    return (size_t)((shift + 1U) * HISTOGRAM_SUB_BUCKETS + ((magnitude >> shift) - HISTOGRAM_SUB_BUCKETS));
+}
+
+static void histogram_magnitude_range(size_t index, uint32_t* lowest, uint32_t* highest)
+{
+    if (index < HISTOGRAM_SUB_BUCKETS) {
+        *lowest = (uint32_t)index;
+        *highest = (uint32_t)index;
+        return;
+    }
+
+    uint32_t const shift = (uint32_t)(index / HISTOGRAM_SUB_BUCKETS) - 1U;
+    uint32_t const sub_bucket = (uint32_t)(index % HISTOGRAM_SUB_BUCKETS);
+
+    *lowest = (HISTOGRAM_SUB_BUCKETS + sub_bucket) << shift;
+    *highest = *lowest + (1U << shift) - 1U;
+}
+
+histogram_err_t histogram_initialize(histogram_t* histogram)
+{
+    assert(histogram);
+
+    return histogram_reset(histogram);
+}
+
+histogram_err_t histogram_deinitialize(histogram_t* histogram)
+{
+    assert(histogram);
+
+    memset(histogram, 0, sizeof(*histogram));
+
+    return HISTOGRAM_ERR_OK;
+}
+
+histogram_err_t histogram_reset(histogram_t* histogram)
+{
+    assert(histogram);
+
+    memset(histogram, 0, sizeof(*histogram));
+
+    return HISTOGRAM_ERR_OK;
+}
+
+histogram_err_t histogram_insert(histogram_t* histogram, int16_t value, uint64_t timestamp_us)
+{
+    assert(histogram);
+
+    uint32_t* count = &histogram->counts[histogram_get_index(value)];
+    if (*count != UINT32_MAX) {
+        ++*count;
+    }
+
+    if (histogram->total == 0U) {
+        histogram->min = value;
+        histogram->max = value;
+        histogram->start_us = timestamp_us;
+    } else if (value < histogram->min) {
+        histogram->min = value;
+    } else if (value > histogram->max) {
+        histogram->max = value;
+    }
+    histogram->end_us = timestamp_us;
+    histogram->sum += value;
+    ++histogram->total;
+
+    return HISTOGRAM_ERR_OK;
+}
+
+histogram_err_t histogram_merge(histogram_t* histogram, histogram_t const* other)
+{
+    assert(histogram && other);
+
+    if (other->total == 0U) {
+        return HISTOGRAM_ERR_OK;
+    }
+
+    for (size_t i = 0U; i < HISTOGRAM_BUCKETS; ++i) {
+        uint32_t const room = UINT32_MAX - histogram->counts[i];
+        histogram->counts[i] += other->counts[i] < room ? other->counts[i] : room;
+    }
+
+    if (histogram->total == 0U) {
+        histogram->min = other->min;
+        histogram->max = other->max;
+        histogram->start_us = other->start_us;
+        histogram->end_us = other->end_us;
+    } else {
+        histogram->min = other->min < histogram->min ? other->min : histogram->min;
+        histogram->max = other->max > histogram->max ? other->max : histogram->max;
+        histogram->start_us = other->start_us < histogram->start_us ? other->start_us : histogram->start_us;
+        histogram->end_us = other->end_us > histogram->end_us ? other->end_us : histogram->end_us;
+    }
+    histogram->sum += other->sum;
+    histogram->total += other->total;
+
+    return HISTOGRAM_ERR_OK;
+}
+
+size_t histogram_get_index(int16_t value)
+{
+    if (value >= 0) {
+        return HISTOGRAM_MAGNITUDE_BUCKETS + histogram_magnitude_index((uint32_t)value);
+    }
+
+    return HISTOGRAM_MAGNITUDE_BUCKETS - histogram_magnitude_index((uint32_t)-(int32_t)value);
+}
+
+histogram_err_t histogram_get_range(size_t index, int32_t* lowest, int32_t* highest)
+{
+    assert(lowest && highest);
+
+    if (index == 0U || index >= HISTOGRAM_BUCKETS) {
+        return HISTOGRAM_ERR_FAIL;
+    }
+
+    uint32_t low = 0U;
+    uint32_t high = 0U;
+
+    if (index >= HISTOGRAM_MAGNITUDE_BUCKETS) {
+        histogram_magnitude_range(index - HISTOGRAM_MAGNITUDE_BUCKETS, &low, &high);
+        *lowest = (int32_t)low;
+        *highest = (int32_t)high;
+    } else {
+        histogram_magnitude_range(HISTOGRAM_MAGNITUDE_BUCKETS - index, &low, &high);
+        *lowest = -(int32_t)high;
+        *highest = -(int32_t)low;
+    }
+
+    return HISTOGRAM_ERR_OK;
+}
+
+histogram_err_t histogram_get_quantile(histogram_t const* histogram, uint32_t quantile_ppm, int16_t* value)
+{
+    assert(histogram && value);
+
+    if (histogram->total == 0U || quantile_ppm > HISTOGRAM_QUANTILE_SCALE) {
+        return HISTOGRAM_ERR_EMPTY;
+    }
+
+    // the rank of the quantile sample, counted from 1
+    uint64_t rank = (histogram->total * quantile_ppm + HISTOGRAM_QUANTILE_SCALE - 1U) / HISTOGRAM_QUANTILE_SCALE;
+    if (rank == 0U) {
+        rank = 1U;
+    }
+
+    uint64_t seen = 0U;
+    for (size_t i = 1U; i < HISTOGRAM_BUCKETS; ++i) {
+        seen += histogram->counts[i];
+        if (seen < rank) {
+            continue;
+        }
+
+        int32_t lowest = 0;
+        int32_t highest = 0;
+        histogram_get_range(i, &lowest, &highest);
+        *value = (int16_t)(highest > histogram->max ? histogram->max : highest < histogram->min ? histogram->min : highest);
+        return HISTOGRAM_ERR_OK;
+    }
+
+    // saturated buckets hold fewer than total
+    *value = histogram->max;
+
+    return HISTOGRAM_ERR_OK;
+}
@@ -0,0 +1,33 @@
+#ifndef HISTOGRAM_HISTOGRAM_H
+#define HISTOGRAM_HISTOGRAM_H
+
+#include "histogram_config.h"
+
+typedef struct {
+    // saturate instead of wrapping, which takes 49 days of one bucket at 1 kHz
+    uint32_t counts[HISTOGRAM_BUCKETS];
+    uint64_t total;
+    int64_t sum;
+    int16_t min;
+    int16_t max;
+    // first and latest insert since the reset
+    uint64_t start_us;
+    uint64_t end_us;
+} histogram_t;
+
+histogram_err_t histogram_initialize(histogram_t* histogram);
+histogram_err_t histogram_deinitialize(histogram_t* histogram);
+
+histogram_err_t histogram_reset(histogram_t* histogram);
+histogram_err_t histogram_insert(histogram_t* histogram, int16_t value, uint64_t timestamp_us);
+// snapshots share the layout, so adding them up gives the histogram of both runs
+histogram_err_t histogram_merge(histogram_t* histogram, histogram_t const* other);
+
+size_t histogram_get_index(int16_t value);
+// the values that fall into a bucket, both inclusive
+histogram_err_t histogram_get_range(size_t index, int32_t* lowest, int32_t* highest);
+// the highest value of the bucket holding the quantile, clamped to the values seen, so the
+// answer is never below the true quantile by more than a bucket width
+histogram_err_t histogram_get_quantile(histogram_t const* histogram, uint32_t quantile_ppm, int16_t* value);
+
+#endif // HISTOGRAM_HISTOGRAM_H
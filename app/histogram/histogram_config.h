@@ -0,0 +1,28 @@
+#ifndef HISTOGRAM_HISTOGRAM_CONFIG_H
+#define HISTOGRAM_HISTOGRAM_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// HDR-style log-linear layout: magnitudes below 2^SUB_BUCKET_BITS get one bucket each, every
+// power of two above that is split into 2^SUB_BUCKET_BITS buckets, so no bucket is wider
+// than 1/2^SUB_BUCKET_BITS of the values in it
+#define HISTOGRAM_SUB_BUCKET_BITS 5U
+#define HISTOGRAM_SUB_BUCKETS (1U << HISTOGRAM_SUB_BUCKET_BITS)
+// magnitudes up to 2^15, which only the most negative reading reaches
+#define HISTOGRAM_MAGNITUDE_BUCKETS ((16U - HISTOGRAM_SUB_BUCKET_BITS + 1U) * HISTOGRAM_SUB_BUCKETS)
+// negative readings below, zero and positive ones from the middle up, in value order
+#define HISTOGRAM_BUCKETS (2U * HISTOGRAM_MAGNITUDE_BUCKETS)
+
+// quantiles are given in parts per million
+#define HISTOGRAM_QUANTILE_SCALE 1000000U
+
+typedef enum {
+    HISTOGRAM_ERR_OK = 0,
+    HISTOGRAM_ERR_FAIL = 1 << 0,
+    HISTOGRAM_ERR_NULL = 1 << 1,
+    HISTOGRAM_ERR_EMPTY = 1 << 2,
+} histogram_err_t;
+
+#endif // HISTOGRAM_HISTOGRAM_CONFIG_H
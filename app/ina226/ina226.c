@@ -2,6 +2,21 @@
 #include <assert.h>
 #include <string.h>
 
+extern inline uint32_t ina226_vbus_ct_to_conversion_time_us(ina226_vbus_ct_t vbus_ct);
+extern inline uint32_t ina226_vsh_ct_to_conversion_time_us(ina226_vsh_ct_t vsh_ct);
+extern inline uint32_t ina226_avg_to_samples(ina226_avg_t avg);
+extern inline uint32_t ina226_get_conversion_time_us(ina226_avg_t avg,
+                                                     ina226_vbus_ct_t vbus_ct,
+                                                     ina226_vsh_ct_t vsh_ct,
+                                                     ina226_mode_t mode);
+extern inline float32_t ina226_current_range_to_scale(float32_t current_range);
+extern inline float32_t ina226_scale_and_shunt_resistance_to_calibration(float32_t scale,
+                                                                         float32_t shunt_resistance);
+extern inline float32_t ina226_current_to_power_scale(float32_t current_scale);
+extern inline float32_t ina226_calibration_to_corrected_calibration(float32_t calibration,
+                                                                    float32_t shunt_current,
+                                                                    float32_t device_current);
+
 static ina226_err_t ina226_bus_init(ina226_t const* ina226)
 {
     return ina226->interface.bus_init ? ina226->interface.bus_init(ina226->interface.bus_user)
@@ -34,6 +49,109 @@ static ina226_err_t ina226_bus_read(ina226_t const* ina226,
                : INA226_ERR_NULL;
 }
 
+static ina226_err_t ina226_timer_get_us(ina226_t const* ina226, uint64_t* us)
+{
+    return ina226->interface.timer_get_us
+               ? ina226->interface.timer_get_us(ina226->interface.timer_user, us)
+               : INA226_ERR_NULL;
+}
+
+static ina226_err_t ina226_timer_delay_us(ina226_t const* ina226, uint32_t us)
+{
+    return ina226->interface.timer_delay_us
+               ? ina226->interface.timer_delay_us(ina226->interface.timer_user, us)
+               : INA226_ERR_NULL;
+}
+
+static ina226_err_t ina226_alert_wait(ina226_t const* ina226, uint32_t timeout_us)
+{
+    return ina226->interface.alert_wait
+               ? ina226->interface.alert_wait(ina226->interface.alert_user, timeout_us)
+               : INA226_ERR_NULL;
+}
+
+static ina226_config_reg_t const ina226_default_config_reg = {
+    .avg = INA226_AVERAGING_MODE_1_SAMPLE,
+    .vbus_ct = INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+    .vsh_ct = INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1,
+    .mode = INA226_OPERATING_MODE_SHUNT_BUS_CONTINUOUS,
+};
+
+static void ina226_restart_conversion(ina226_t* ina226, ina226_config_reg_t const* reg)
+{
+    ina226->config_reg = reg->rst ? ina226_default_config_reg : *reg;
+    ina226->conversion_time_us = ina226_config_reg_to_conversion_time_us(&ina226->config_reg);
+
+    if (ina226_timer_get_us(ina226, &ina226->conversion_start_us) != INA226_ERR_OK) {
+        ina226->conversion_start_us = 0U;
+    }
+}
+
+static void ina226_config_written(ina226_t* ina226, ina226_config_reg_t const* reg)
+{
+    ina226_restart_conversion(ina226, reg);
+    ina226->shadow_valid |= INA226_SHADOW_CONFIG;
+
+    // a reset returns the other registers to their power-on zero as well
+    if (reg->rst) {
+        ina226->calibration_word = 0U;
+        ina226->mask_enable_word = 0U;
+        ina226->alert_limit_word = 0U;
+        ina226->shadow_valid = INA226_SHADOW_ALL;
+    }
+}
+
+static ina226_config_reg_t ina226_word_to_config_reg(uint16_t word)
+{
+    return (ina226_config_reg_t){
+        .rst = (word >> 15U) & 0x01U,
+        .avg = (word >> 9U) & 0x07U,
+        .vbus_ct = (word >> 6U) & 0x07U,
+        .vsh_ct = (word >> 3U) & 0x07U,
+        .mode = word & 0x07U,
+    };
+}
+
+static uint16_t ina226_mask_enable_reg_to_word(ina226_mask_enable_reg_t const* reg)
+{
+    return (uint16_t)(((reg->sol & 0x01U) << 15U) | ((reg->sul & 0x01U) << 14U) |
+                      ((reg->bol & 0x01U) << 13U) | ((reg->bul & 0x01U) << 12U) |
+                      ((reg->pol & 0x01U) << 11U) | ((reg->cnvr & 0x01U) << 10U) |
+                      ((reg->aff & 0x01U) << 4U) | ((reg->cvrf & 0x01U) << 3U) |
+                      ((reg->ovf & 0x01U) << 2U) | ((reg->apol & 0x01U) << 1U) | (reg->len & 0x01U));
+}
+
+static ina226_err_t ina226_write_word(ina226_t const* ina226, ina226_reg_address_t address, uint16_t word)
+{
+    uint8_t const data[2] = {(uint8_t)(word >> 8U), (uint8_t)(word & 0xFFU)};
+
+    return ina226_bus_write(ina226, (uint8_t)address, data, sizeof(data));
+}
+
+// a failed write leaves the register in an unknown state, so the shadow is dropped with it
+static ina226_err_t ina226_write_shadowed(ina226_t* ina226,
+                                          ina226_reg_address_t address,
+                                          ina226_shadow_t shadow,
+                                          uint16_t* image,
+                                          uint16_t word)
+{
+    ina226_err_t err = ina226_write_word(ina226, address, word);
+
+    if (err == INA226_ERR_OK) {
+        *image = word;
+        ina226->shadow_valid |= (uint8_t)shadow;
+    } else {
+        ina226->shadow_valid &= (uint8_t)~shadow;
+    }
+
+    return err;
+}
+
+static bool ina226_is_shadowed(ina226_t const* ina226, ina226_shadow_t shadow, uint16_t image, uint16_t word)
+{
+    return (ina226->shadow_valid & shadow) && image == word;
+}
+
 ina226_err_t ina226_initialize(ina226_t* ina226,
                                ina226_config_t const* config,
                                ina226_interface_t const* interface)
@@ -44,6 +162,8 @@ ina226_err_t ina226_initialize(ina226_t* ina226,
     memcpy(&ina226->config, config, sizeof(*config));
     memcpy(&ina226->interface, interface, sizeof(*interface));
 
+    ina226_restart_conversion(ina226, &ina226_default_config_reg);
+
     return ina226_bus_init(ina226);
 }
 
@@ -66,7 +186,7 @@ ina226_err_t ina226_get_current_scaled(ina226_t const* ina226, float32_t* scaled
 
     ina226_err_t err = ina226_get_current_raw(ina226, &raw);
 
-    *scaled = (float32_t)raw * ina226->config.current_scale;
+    *scaled = (float32_t)raw * ina226_get_scale(ina226, INA226_QUANTITY_CURRENT);
 
     return err;
 }
@@ -79,7 +199,7 @@ ina226_err_t ina226_get_bus_voltage_scaled(ina226_t const* ina226, float32_t* sc
 
     ina226_err_t err = ina226_get_bus_voltage_raw(ina226, &raw);
 
-    *scaled = (float32_t)raw * INA226_BUS_VOLTAGE_SCALE;
+    *scaled = (float32_t)raw * ina226_get_scale(ina226, INA226_QUANTITY_BUS_VOLTAGE);
 
     return err;
 }
@@ -92,7 +212,7 @@ ina226_err_t ina226_get_shunt_voltage_scaled(ina226_t const* ina226, float32_t*
 
     ina226_err_t err = ina226_get_shunt_voltage_raw(ina226, &raw);
 
-    *scaled = (float32_t)raw * INA226_SHUNT_VOLTAGE_SCALE;
+    *scaled = (float32_t)raw * ina226_get_scale(ina226, INA226_QUANTITY_SHUNT_VOLTAGE);
 
     return err;
 }
@@ -107,7 +227,127 @@ ina226_err_t ina226_get_power_scaled(ina226_t const* ina226, float32_t* scaled)
 
     ina226_err_t err = ina226_get_power_raw(ina226, &raw);
 
-    *scaled = (float32_t)raw * ina226_current_to_power_scale(ina226->config.current_scale);
+    *scaled = (float32_t)raw * ina226_get_scale(ina226, INA226_QUANTITY_POWER);
+
+    return err;
+}
+
+uint16_t ina226_config_reg_to_word(ina226_config_reg_t const* reg)
+{
+    assert(reg);
+
+    return (uint16_t)(((reg->rst & 0x01U) << 15U) |
+                      INA226_CONFIG_WORD(reg->avg, reg->vbus_ct, reg->vsh_ct, reg->mode));
+}
+
+ina226_err_t ina226_apply_profile(ina226_t* ina226, ina226_profile_t const* profile)
+{
+    assert(ina226 && profile);
+
+    ina226_err_t err = INA226_ERR_OK;
+
+    // reserved and read-only bits are normalized, so they cannot force a write on every apply
+    uint16_t const calibration = profile->calibration & 0x7FFFU;
+    uint16_t const mask_enable = profile->mask_enable & INA226_MASK_ENABLE_WRITABLE;
+    uint16_t const config = (uint16_t)((profile->config & 0x0FFFU) | 0x4000U);
+
+    if (!ina226_is_shadowed(ina226, INA226_SHADOW_CALIBRATION, ina226->calibration_word, calibration)) {
+        err |= ina226_write_shadowed(ina226,
+                                     INA226_REG_ADDRESS_CALIBRATION,
+                                     INA226_SHADOW_CALIBRATION,
+                                     &ina226->calibration_word,
+                                     calibration);
+    }
+    if (!ina226_is_shadowed(ina226, INA226_SHADOW_MASK_ENABLE, ina226->mask_enable_word, mask_enable)) {
+        err |= ina226_write_shadowed(ina226,
+                                     INA226_REG_ADDRESS_MASK_ENABLE,
+                                     INA226_SHADOW_MASK_ENABLE,
+                                     &ina226->mask_enable_word,
+                                     mask_enable);
+    }
+    if (!ina226_is_shadowed(ina226, INA226_SHADOW_ALERT_LIMIT, ina226->alert_limit_word, profile->alert_limit)) {
+        err |= ina226_write_shadowed(ina226,
+                                     INA226_REG_ADDRESS_ALERT_LIMIT,
+                                     INA226_SHADOW_ALERT_LIMIT,
+                                     &ina226->alert_limit_word,
+                                     profile->alert_limit);
+    }
+    if (!ina226_is_shadowed(ina226, INA226_SHADOW_CONFIG, ina226_config_reg_to_word(&ina226->config_reg), config)) {
+        ina226_config_reg_t const reg = ina226_word_to_config_reg(config);
+        err |= ina226_set_config_reg(ina226, &reg);
+    }
+
+    return err;
+}
+
+void ina226_invalidate_shadow(ina226_t* ina226)
+{
+    assert(ina226);
+
+    ina226->shadow_valid = 0U;
+}
+
+ina226_err_t ina226_update_alert_limit(ina226_t* ina226, uint16_t alert_limit)
+{
+    assert(ina226);
+
+    if (ina226_is_shadowed(ina226, INA226_SHADOW_ALERT_LIMIT, ina226->alert_limit_word, alert_limit)) {
+        return INA226_ERR_OK;
+    }
+
+    return ina226_write_shadowed(ina226,
+                                 INA226_REG_ADDRESS_ALERT_LIMIT,
+                                 INA226_SHADOW_ALERT_LIMIT,
+                                 &ina226->alert_limit_word,
+                                 alert_limit);
+}
+
+uint32_t ina226_config_reg_to_conversion_time_us(ina226_config_reg_t const* reg)
+{
+    assert(reg);
+
+    return ina226_get_conversion_time_us((ina226_avg_t)reg->avg,
+                                         (ina226_vbus_ct_t)reg->vbus_ct,
+                                         (ina226_vsh_ct_t)reg->vsh_ct,
+                                         (ina226_mode_t)reg->mode);
+}
+
+ina226_err_t ina226_get_ready_time(ina226_t const* ina226, uint64_t now_us, uint64_t* ready_us)
+{
+    assert(ina226 && ready_us);
+
+    if (ina226->conversion_time_us == 0U) {
+        return INA226_ERR_FAIL;
+    }
+
+    uint64_t first_ready_us = ina226->conversion_start_us + ina226->conversion_time_us;
+
+    if (now_us <= first_ready_us ||
+        ina226->config_reg.mode < INA226_OPERATING_MODE_SHUNT_CONTINUOUS) {
+        *ready_us = first_ready_us;
+    } else {
+        uint64_t conversions =
+            (now_us - ina226->conversion_start_us + ina226->conversion_time_us - 1U) /
+            ina226->conversion_time_us;
+        *ready_us = ina226->conversion_start_us + conversions * ina226->conversion_time_us;
+    }
+
+    return INA226_ERR_OK;
+}
+
+ina226_err_t ina226_wait_ready(ina226_t const* ina226)
+{
+    assert(ina226);
+
+    uint64_t now_us = {};
+    uint64_t ready_us = {};
+
+    ina226_err_t err = ina226_timer_get_us(ina226, &now_us);
+    err |= ina226_get_ready_time(ina226, now_us, &ready_us);
+
+    if (err == INA226_ERR_OK && ready_us > now_us) {
+        err = ina226_timer_delay_us(ina226, (uint32_t)(ready_us - now_us));
+    }
 
     return err;
 }
@@ -168,6 +408,99 @@ ina226_err_t ina226_get_power_raw(ina226_t const* ina226, int16_t* raw)
     return err;
 }
 
+ina226_err_t ina226_get_snapshot(ina226_t const* ina226, ina226_snapshot_t* snapshot)
+{
+    assert(ina226 && snapshot);
+
+    ina226_err_t err = ina226_get_shunt_voltage_raw(ina226, &snapshot->shunt_voltage);
+    err |= ina226_get_bus_voltage_raw(ina226, &snapshot->bus_voltage);
+    err |= ina226_get_current_raw(ina226, &snapshot->current);
+    err |= ina226_get_power_raw(ina226, &snapshot->power);
+
+    snapshot->is_conversion_ready = false;
+
+    return err;
+}
+
+ina226_err_t ina226_get_snapshot_with_cvrf(ina226_t const* ina226, ina226_snapshot_t* snapshot)
+{
+    assert(ina226 && snapshot);
+
+    ina226_mask_enable_reg_t reg = {};
+
+    ina226_err_t err = ina226_get_mask_enable_reg(ina226, &reg);
+    err |= ina226_get_snapshot(ina226, snapshot);
+
+    snapshot->is_conversion_ready = reg.cvrf;
+
+    return err;
+}
+
+ina226_err_t ina226_prepare_trigger(ina226_t* ina226, ina226_mode_t mode)
+{
+    assert(ina226);
+
+    if (mode < INA226_OPERATING_MODE_SHUNT_TRIGGERED ||
+        mode > INA226_OPERATING_MODE_SHUNT_BUS_TRIGGERED) {
+        return INA226_ERR_FAIL;
+    }
+
+    ina226->trigger_reg = ina226->config_reg;
+    ina226->trigger_reg.rst = 0U;
+    ina226->trigger_reg.mode = mode & 0x07U;
+
+    uint16_t const word = ina226_config_reg_to_word(&ina226->trigger_reg);
+    ina226->trigger_data[0] = (uint8_t)(word >> 8U);
+    ina226->trigger_data[1] = (uint8_t)(word & 0xFFU);
+
+    return INA226_ERR_OK;
+}
+
+ina226_err_t ina226_trigger(ina226_t* ina226)
+{
+    assert(ina226);
+
+    if (ina226->trigger_reg.mode == INA226_OPERATING_MODE_POWER_DOWN) {
+        return INA226_ERR_FAIL;
+    }
+
+    ina226_err_t err = ina226_bus_write(ina226,
+                                        INA226_REG_ADDRESS_CONFIG,
+                                        ina226->trigger_data,
+                                        sizeof(ina226->trigger_data));
+    if (err == INA226_ERR_OK) {
+        ina226_config_written(ina226, &ina226->trigger_reg);
+    }
+
+    return err;
+}
+
+ina226_err_t ina226_trigger_and_read(ina226_t* ina226, ina226_snapshot_t* snapshot)
+{
+    assert(ina226 && snapshot);
+
+    ina226_err_t err = ina226_trigger(ina226);
+    if (err != INA226_ERR_OK) {
+        return err;
+    }
+
+    if (ina226->interface.alert_wait) {
+        err = ina226_alert_wait(ina226,
+                                ina226->conversion_time_us + INA226_ALERT_TIMEOUT_MARGIN_US);
+    } else {
+        err = ina226_wait_ready(ina226);
+    }
+    if (err != INA226_ERR_OK) {
+        return err;
+    }
+
+    err = ina226_get_snapshot(ina226, snapshot);
+
+    snapshot->is_conversion_ready = true;
+
+    return err;
+}
+
 ina226_err_t ina226_get_config_reg(ina226_t const* ina226, ina226_config_reg_t* reg)
 {
     assert(ina226 && reg);
@@ -186,25 +519,18 @@ ina226_err_t ina226_get_config_reg(ina226_t const* ina226, ina226_config_reg_t*
     return err;
 }
 
-ina226_err_t ina226_set_config_reg(ina226_t const* ina226, ina226_config_reg_t const* reg)
+ina226_err_t ina226_set_config_reg(ina226_t* ina226, ina226_config_reg_t const* reg)
 {
     assert(ina226 && reg);
 
-    uint8_t data[2] = {};
-
-    ina226_err_t err = ina226_bus_read(ina226, INA226_REG_ADDRESS_CONFIG, data, sizeof(data));
-
-    data[0] &= ~((0x01U << 7U) | (0x07U << 1U) | 0x80U);
-    data[1] &= ~((0x03U << 6U) | (0x07U << 3U) | 0x07U);
-
-    data[0] |= (reg->rst & 0x01U) << 7U;
-    data[0] |= (reg->avg & 0x07U) << 1U;
-    data[0] |= (reg->vbus_ct & 0x80U);
-    data[1] |= (reg->vbus_ct & 0x3U) << 6U;
-    data[1] |= (reg->vsh_ct & 0x07U) << 3U;
-    data[1] |= reg->mode & 0x07U;
+    // every writable field comes from reg, so there is nothing to read back first
+    ina226_err_t err = ina226_write_word(ina226, INA226_REG_ADDRESS_CONFIG, ina226_config_reg_to_word(reg));
 
-    err |= ina226_bus_write(ina226, INA226_REG_ADDRESS_CONFIG, data, sizeof(data));
+    if (err == INA226_ERR_OK) {
+        ina226_config_written(ina226, reg);
+    } else {
+        ina226->shadow_valid &= (uint8_t)~INA226_SHADOW_CONFIG;
+    }
 
     return err;
 }
@@ -218,7 +544,7 @@ ina226_err_t ina226_get_shunt_voltage_reg(ina226_t const* ina226, ina226_shunt_v
     ina226_err_t err =
         ina226_bus_read(ina226, INA226_REG_ADDRESS_SHUNT_VOLTAGE, data, sizeof(data));
 
-    reg->voltage = (int16_t)(((data[0] & 0xFF) << 8) | (data[0] & 0xFF));
+    reg->voltage = (int16_t)(((data[0] & 0xFF) << 8) | (data[1] & 0xFF));
 
     return err;
 }
@@ -231,7 +557,7 @@ ina226_err_t ina226_get_bus_voltage_reg(ina226_t const* ina226, ina226_bus_volta
 
     ina226_err_t err = ina226_bus_read(ina226, INA226_REG_ADDRESS_BUS_VOLTAGE, data, sizeof(data));
 
-    reg->voltage = (int16_t)(((data[0] & 0xFF) << 8) | (data[0] & 0xFF));
+    reg->voltage = (int16_t)(((data[0] & 0xFF) << 8) | (data[1] & 0xFF));
 
     return err;
 }
@@ -244,7 +570,7 @@ ina226_err_t ina226_get_power_reg(ina226_t const* ina226, ina226_power_reg_t* re
 
     ina226_err_t err = ina226_bus_read(ina226, INA226_REG_ADDRESS_POWER, data, sizeof(data));
 
-    reg->power = (int16_t)(((data[0] & 0xFF) << 8) | (data[0] & 0xFF));
+    reg->power = (int16_t)(((data[0] & 0xFF) << 8) | (data[1] & 0xFF));
 
     return err;
 }
@@ -257,7 +583,7 @@ ina226_err_t ina226_get_current_reg(ina226_t const* ina226, ina226_current_reg_t
 
     ina226_err_t err = ina226_bus_read(ina226, INA226_REG_ADDRESS_CURRENT, data, sizeof(data));
 
-    reg->current = (int16_t)(((data[0] & 0xFF) << 8) | (data[0] & 0xFF));
+    reg->current = (int16_t)(((data[0] & 0xFF) << 8) | (data[1] & 0xFF));
 
     return err;
 }
@@ -270,26 +596,20 @@ ina226_err_t ina226_get_calibration_reg(ina226_t const* ina226, ina226_calibrati
 
     ina226_err_t err = ina226_bus_read(ina226, INA226_REG_ADDRESS_CALIBRATION, data, sizeof(data));
 
-    reg->fs = (int16_t)(((data[0] & 0x7F) << 7) | (data[1] & 0xFF));
+    reg->fs = (uint16_t)(((data[0] & 0x7F) << 8) | (data[1] & 0xFF));
 
     return err;
 }
 
-ina226_err_t ina226_set_calibration_reg(ina226_t const* ina226, ina226_calibration_reg_t const* reg)
+ina226_err_t ina226_set_calibration_reg(ina226_t* ina226, ina226_calibration_reg_t const* reg)
 {
     assert(ina226 && reg);
 
-    uint8_t data[2] = {};
-
-    ina226_err_t err = ina226_bus_read(ina226, INA226_REG_ADDRESS_CALIBRATION, data, sizeof(data));
-
-    data[0] &= ~0x7F;
-    data[1] &= ~0xFF;
-
-    data[0] |= (uint8_t)((reg->fs >> 8) & 0x7F);
-    data[1] |= (uint8_t)(reg->fs & 0xFF);
-
-    return err;
+    return ina226_write_shadowed(ina226,
+                                 INA226_REG_ADDRESS_CALIBRATION,
+                                 INA226_SHADOW_CALIBRATION,
+                                 &ina226->calibration_word,
+                                 (uint16_t)reg->fs & 0x7FFFU);
 }
 
 ina226_err_t ina226_get_mask_enable_reg(ina226_t const* ina226, ina226_mask_enable_reg_t* reg)
@@ -315,33 +635,16 @@ ina226_err_t ina226_get_mask_enable_reg(ina226_t const* ina226, ina226_mask_enab
     return err;
 }
 
-ina226_err_t ina226_set_mask_enable_reg(ina226_t const* ina226, ina226_mask_enable_reg_t const* reg)
+ina226_err_t ina226_set_mask_enable_reg(ina226_t* ina226, ina226_mask_enable_reg_t const* reg)
 {
     assert(ina226 && reg);
 
-    uint8_t data[2] = {};
-
-    ina226_err_t err = ina226_bus_read(ina226, INA226_REG_ADDRESS_MASK_ENABLE, data, sizeof(data));
-
-    data[0] &= ~((0x01U << 7U) | (0x01U << 6U) | (0x01U << 5U) | (0x01U << 4U) | (0x01U << 3U) |
-                 (0x01U << 2U));
-    data[1] &= ~((0x01 << 4U) | (0x01 << 3U) | (0x01 << 2U) | (0x01 << 1U) | 0x01);
-
-    data[0] |= (reg->sol & 0x01U) << 7U;
-    data[0] |= (reg->sul & 0x01U) << 6U;
-    data[0] |= (reg->bol & 0x01U) << 5U;
-    data[0] |= (reg->bul & 0x01U) << 4U;
-    data[0] |= (reg->pol & 0x01U) << 3U;
-    data[0] |= (reg->cnvr & 0x01U) << 2U;
-    data[1] |= (reg->aff & 0x01U) << 4U;
-    data[1] |= (reg->cvrf & 0x01U) << 3U;
-    data[1] |= (reg->ovf & 0x01U) << 2U;
-    data[1] |= (reg->apol & 0x01U) << 1U;
-    data[1] |= reg->len & 0x01U;
-
-    err |= ina226_bus_write(ina226, INA226_REG_ADDRESS_MASK_ENABLE, data, sizeof(data));
-
-    return err;
+    // the flags between the enable bits are read-only and ignored on write
+    return ina226_write_shadowed(ina226,
+                                 INA226_REG_ADDRESS_MASK_ENABLE,
+                                 INA226_SHADOW_MASK_ENABLE,
+                                 &ina226->mask_enable_word,
+                                 ina226_mask_enable_reg_to_word(reg));
 }
 
 ina226_err_t ina226_get_alert_limit_reg(ina226_t const* ina226, ina226_alert_limit_reg_t* reg)
@@ -357,16 +660,15 @@ ina226_err_t ina226_get_alert_limit_reg(ina226_t const* ina226, ina226_alert_lim
     return err;
 }
 
-ina226_err_t ina226_set_alert_limit_reg(ina226_t const* ina226, ina226_alert_limit_reg_t const* reg)
+ina226_err_t ina226_set_alert_limit_reg(ina226_t* ina226, ina226_alert_limit_reg_t const* reg)
 {
     assert(ina226 && reg);
 
-    uint8_t data[2] = {};
-
-    data[0] |= (uint8_t)((reg->aul >> 8) & 0xFF);
-    data[1] |= (uint8_t)(reg->aul & 0xFF);
-
-    return ina226_bus_write(ina226, INA226_REG_ADDRESS_ALERT_LIMIT, data, sizeof(data));
+    return ina226_write_shadowed(ina226,
+                                 INA226_REG_ADDRESS_ALERT_LIMIT,
+                                 INA226_SHADOW_ALERT_LIMIT,
+                                 &ina226->alert_limit_word,
+                                 (uint16_t)reg->aul);
 }
 
 ina226_err_t ina226_get_manufacturer_id_reg(ina226_t const* ina226,
@@ -397,3 +699,16 @@ ina226_err_t ina226_get_die_id_reg(ina226_t const* ina226, ina226_die_id_reg_t*
 
     return err;
 }
+
+ina226_err_t ina226_get_reg_raw(ina226_t const* ina226, ina226_reg_address_t address, uint16_t* raw)
+{
+    assert(ina226 && raw);
+
+    uint8_t data[2] = {};
+
+    ina226_err_t err = ina226_bus_read(ina226, (uint8_t)address, data, sizeof(data));
+
+    *raw = (uint16_t)(((data[0] & 0xFFU) << 8U) | (data[1] & 0xFFU));
+
+    return err;
+}
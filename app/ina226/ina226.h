@@ -7,6 +7,20 @@
 typedef struct {
     ina226_config_t config;
     ina226_interface_t interface;
+
+    ina226_config_reg_t config_reg;
+    uint32_t conversion_time_us;
+    uint64_t conversion_start_us;
+
+    ina226_config_reg_t trigger_reg;
+    uint8_t trigger_data[2];
+
+    // images of the last writes, together with config_reg what ina226_apply_profile compares
+    // against; a register without its ina226_shadow_t bit is unknown and always written
+    uint16_t calibration_word;
+    uint16_t mask_enable_word;
+    uint16_t alert_limit_word;
+    uint8_t shadow_valid;
 } ina226_t;
 
 ina226_err_t ina226_initialize(ina226_t* ina226, ina226_config_t const* config, ina226_interface_t const* interface);
@@ -17,13 +31,71 @@ ina226_err_t ina226_get_bus_voltage_scaled(ina226_t const* ina226, float32_t* sc
 ina226_err_t ina226_get_shunt_voltage_scaled(ina226_t const* ina226, float32_t* scaled);
 ina226_err_t ina226_get_power_scaled(ina226_t const* ina226, float32_t* scaled);
 
+// volts, amperes or watts per LSB of the quantity's register
+float32_t ina226_get_scale(ina226_t const* ina226, ina226_quantity_t quantity);
+// converts count raw readings in one pass, vectorized where the target allows; raw and
+// scaled must not overlap
+void ina226_scale_block(int16_t const* raw, float32_t* scaled, size_t count, float32_t scale);
+// the plain loop the vector variants are checked against, bit-identical to them
+void ina226_scale_block_generic(int16_t const* raw, float32_t* scaled, size_t count, float32_t scale);
+ina226_err_t ina226_scale_quantity_block(ina226_t const* ina226,
+                                         ina226_quantity_t quantity,
+                                         int16_t const* raw,
+                                         float32_t* scaled,
+                                         size_t count);
+
+uint32_t ina226_config_reg_to_conversion_time_us(ina226_config_reg_t const* reg);
+uint16_t ina226_config_reg_to_word(ina226_config_reg_t const* reg);
+
+// writes only the registers whose image differs from the shadow, CONFIG last so the
+// conversion it restarts already runs with the new calibration
+ina226_err_t ina226_apply_profile(ina226_t* ina226, ina226_profile_t const* profile);
+// forgets the shadow, e.g. after the device lost power, so the next profile is written in full
+void ina226_invalidate_shadow(ina226_t* ina226);
+// writes ALERT_LIMIT only when it differs from the shadow, for a limit that follows the pin
+ina226_err_t ina226_update_alert_limit(ina226_t* ina226, uint16_t alert_limit);
+
+// limit and matching MASK_ENABLE function bit for an alert in engineering units, rounded to
+// the nearest LSB and clamped to the register range
+ina226_err_t ina226_alert_to_words(ina226_t const* ina226,
+                                   ina226_alert_t const* alert,
+                                   uint16_t* mask_enable,
+                                   uint16_t* alert_limit);
+// writes ALERT_LIMIT, then MASK_ENABLE; INA226_ALERT_NONE turns the pin off
+ina226_err_t ina226_set_alert(ina226_t* ina226, ina226_alert_t const* alert);
+// reads MASK_ENABLE, which releases a latched ALERT; is_alert is the alert function flag
+ina226_err_t ina226_acknowledge_alert(ina226_t const* ina226, bool* is_alert);
+// when the comparison behind an alert seen at now_us happened: the end of the function's
+// conversion, as tracked from the last CONFIG write, so it drifts with the device clock
+ina226_err_t ina226_get_alert_compare_time(ina226_t const* ina226,
+                                           ina226_alert_function_t function,
+                                           uint64_t now_us,
+                                           uint64_t* compare_us);
+
+// time of the first result completing at or after now_us, tracked from the last CONFIG write
+ina226_err_t ina226_get_ready_time(ina226_t const* ina226, uint64_t now_us, uint64_t* ready_us);
+ina226_err_t ina226_wait_ready(ina226_t const* ina226);
+
 ina226_err_t ina226_get_current_raw(ina226_t const* ina226, int16_t* raw);
 ina226_err_t ina226_get_bus_voltage_raw(ina226_t const* ina226, int16_t* raw);
 ina226_err_t ina226_get_shunt_voltage_raw(ina226_t const* ina226, int16_t* raw);
 ina226_err_t ina226_get_power_raw(ina226_t const* ina226, int16_t* raw);
 
+ina226_err_t ina226_get_snapshot(ina226_t const* ina226, ina226_snapshot_t* snapshot);
+// reads MASK_ENABLE first, which clears CVRF, so is_conversion_ready tells if the results
+// changed since the previous call
+ina226_err_t ina226_get_snapshot_with_cvrf(ina226_t const* ina226, ina226_snapshot_t* snapshot);
+
+// precomputes the CONFIG word for the given triggered mode from the current settings
+ina226_err_t ina226_prepare_trigger(ina226_t* ina226, ina226_mode_t mode);
+// issues only the precomputed CONFIG write and restarts the ready-time tracking
+ina226_err_t ina226_trigger(ina226_t* ina226);
+// one CONFIG write, then waits for the conversion-ready ALERT (needs CNVR enabled in
+// MASK_ENABLE) if alert_wait is provided, otherwise for the computed ready time
+ina226_err_t ina226_trigger_and_read(ina226_t* ina226, ina226_snapshot_t* snapshot);
+
 ina226_err_t ina226_get_config_reg(ina226_t const* ina226, ina226_config_reg_t* reg);
-ina226_err_t ina226_set_config_reg(ina226_t const* ina226, ina226_config_reg_t const* reg);
+ina226_err_t ina226_set_config_reg(ina226_t* ina226, ina226_config_reg_t const* reg);
 
 ina226_err_t ina226_get_shunt_voltage_reg(ina226_t const* ina226, ina226_shunt_voltage_reg_t* reg);
 
@@ -34,16 +106,19 @@ ina226_err_t ina226_get_power_reg(ina226_t const* ina226, ina226_power_reg_t* re
 ina226_err_t ina226_get_current_reg(ina226_t const* ina226, ina226_current_reg_t* reg);
 
 ina226_err_t ina226_get_calibration_reg(ina226_t const* ina226, ina226_calibration_reg_t* reg);
-ina226_err_t ina226_set_calibration_reg(ina226_t const* ina226, ina226_calibration_reg_t const* reg);
+ina226_err_t ina226_set_calibration_reg(ina226_t* ina226, ina226_calibration_reg_t const* reg);
 
 ina226_err_t ina226_get_mask_enable_reg(ina226_t const* ina226, ina226_mask_enable_reg_t* reg);
-ina226_err_t ina226_set_mask_enable_reg(ina226_t const* ina226, ina226_mask_enable_reg_t const* reg);
+ina226_err_t ina226_set_mask_enable_reg(ina226_t* ina226, ina226_mask_enable_reg_t const* reg);
 
 ina226_err_t ina226_get_alert_limit_reg(ina226_t const* ina226, ina226_alert_limit_reg_t* reg);
-ina226_err_t ina226_set_alert_limit_reg(ina226_t const* ina226, ina226_alert_limit_reg_t const* reg);
+ina226_err_t ina226_set_alert_limit_reg(ina226_t* ina226, ina226_alert_limit_reg_t const* reg);
 
 ina226_err_t ina226_get_manufacturer_id_reg(ina226_t const* ina226, ina226_manufacturer_id_reg_t* reg);
 
 ina226_err_t ina226_get_die_id_reg(ina226_t const* ina226, ina226_die_id_reg_t* reg);
 
+// the register word as sent by the device, MSB first on the wire
+ina226_err_t ina226_get_reg_raw(ina226_t const* ina226, ina226_reg_address_t address, uint16_t* raw);
+
 #endif // INA226_INA226_H
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "ina226.h"
+#include <assert.h>
+
+static uint16_t const ina226_alert_mask_bits[INA226_ALERT_COUNT] = {
+    [INA226_ALERT_NONE] = 0U,
+    [INA226_ALERT_SHUNT_OVER_VOLTAGE] = INA226_MASK_ENABLE_SOL,
+    [INA226_ALERT_SHUNT_UNDER_VOLTAGE] = INA226_MASK_ENABLE_SUL,
+    [INA226_ALERT_BUS_OVER_VOLTAGE] = INA226_MASK_ENABLE_BOL,
+    [INA226_ALERT_BUS_UNDER_VOLTAGE] = INA226_MASK_ENABLE_BUL,
+    [INA226_ALERT_POWER_OVER_LIMIT] = INA226_MASK_ENABLE_POL,
+    [INA226_ALERT_CURRENT_OVER_LIMIT] = INA226_MASK_ENABLE_SOL,
+    [INA226_ALERT_CURRENT_UNDER_LIMIT] = INA226_MASK_ENABLE_SUL,
+};
+
+// rounds to the nearest LSB and clamps to what the compared register can hold
+static uint16_t ina226_alert_round(float32_t lsbs, float32_t min, float32_t max)
+{
+    if (lsbs <= min) {
+        return (uint16_t)(int32_t)min;
+    }
+    if (lsbs >= max) {
+        return (uint16_t)(int32_t)max;
+    }
+
+    return (uint16_t)(int32_t)(lsbs >= 0.0F ? lsbs + 0.5F : lsbs - 0.5F);
+}
+
+static bool ina226_alert_is_shunt(ina226_alert_function_t function)
+{
+    return function == INA226_ALERT_SHUNT_OVER_VOLTAGE || function == INA226_ALERT_SHUNT_UNDER_VOLTAGE ||
+           function == INA226_ALERT_CURRENT_OVER_LIMIT || function == INA226_ALERT_CURRENT_UNDER_LIMIT;
+}
+
+ina226_err_t ina226_alert_to_words(ina226_t const* ina226,
+                                   ina226_alert_t const* alert,
+                                   uint16_t* mask_enable,
+                                   uint16_t* alert_limit)
+{
+    assert(ina226 && alert && mask_enable && alert_limit);
+
+    if (alert->function >= INA226_ALERT_COUNT) {
+        return INA226_ERR_FAIL;
+    }
+
+    float32_t const limit = alert->limit;
+
+    switch (alert->function) {
+        case INA226_ALERT_NONE:
+            *alert_limit = 0U;
+            break;
+        case INA226_ALERT_SHUNT_OVER_VOLTAGE:
+        case INA226_ALERT_SHUNT_UNDER_VOLTAGE:
+            *alert_limit = ina226_alert_round(limit / INA226_SHUNT_VOLTAGE_SCALE, (float32_t)INT16_MIN, (float32_t)INT16_MAX);
+            break;
+        case INA226_ALERT_BUS_OVER_VOLTAGE:
+        case INA226_ALERT_BUS_UNDER_VOLTAGE:
+            *alert_limit = ina226_alert_round(limit / INA226_BUS_VOLTAGE_SCALE, 0.0F, (float32_t)INT16_MAX);
+            break;
+        case INA226_ALERT_POWER_OVER_LIMIT:
+            *alert_limit = ina226_alert_round(limit / ina226_get_scale(ina226, INA226_QUANTITY_POWER), 0.0F, (float32_t)UINT16_MAX);
+            break;
+        default:
+            // the current register is shunt * CAL / 2048, so the shunt limit is the inverse
+            if (ina226->config.calibration <= 0.0F) {
+                return INA226_ERR_FAIL;
+            }
+            *alert_limit = ina226_alert_round(limit / ina226->config.current_scale * 2048.0F / ina226->config.calibration,
+                                              (float32_t)INT16_MIN,
+                                              (float32_t)INT16_MAX);
+            break;
+    }
+
+    *mask_enable = (uint16_t)(ina226_alert_mask_bits[alert->function] |
+                              (alert->is_latched && alert->function != INA226_ALERT_NONE ? INA226_MASK_ENABLE_LEN : 0U));
+
+    return INA226_ERR_OK;
+}
+
+ina226_err_t ina226_set_alert(ina226_t* ina226, ina226_alert_t const* alert)
+{
+    assert(ina226 && alert);
+
+    uint16_t mask_enable = 0U;
+    uint16_t alert_limit = 0U;
+
+    ina226_err_t err = ina226_alert_to_words(ina226, alert, &mask_enable, &alert_limit);
+    if (err != INA226_ERR_OK) {
+        return err;
+    }
+
+    // the limit goes first, so the newly selected function never compares against the old one
+    ina226_alert_limit_reg_t const limit_reg = {.aul = (int16_t)alert_limit};
+    err |= ina226_set_alert_limit_reg(ina226, &limit_reg);
+
+    ina226_mask_enable_reg_t const mask_reg = {
+        .sol = (mask_enable & INA226_MASK_ENABLE_SOL) != 0U,
+        .sul = (mask_enable & INA226_MASK_ENABLE_SUL) != 0U,
+        .bol = (mask_enable & INA226_MASK_ENABLE_BOL) != 0U,
+        .bul = (mask_enable & INA226_MASK_ENABLE_BUL) != 0U,
+        .pol = (mask_enable & INA226_MASK_ENABLE_POL) != 0U,
+        .len = (mask_enable & INA226_MASK_ENABLE_LEN) != 0U,
+    };
+    err |= ina226_set_mask_enable_reg(ina226, &mask_reg);
+
+    return err;
+}
+
+ina226_err_t ina226_acknowledge_alert(ina226_t const* ina226, bool* is_alert)
+{
+    assert(ina226);
+
+    ina226_mask_enable_reg_t reg = {0};
+
+    ina226_err_t err = ina226_get_mask_enable_reg(ina226, &reg);
+
+    if (is_alert) {
+        *is_alert = reg.aff;
+    }
+
+    return err;
+}
+
+ina226_err_t ina226_get_alert_compare_time(ina226_t const* ina226,
+                                           ina226_alert_function_t function,
+                                           uint64_t now_us,
+                                           uint64_t* compare_us)
+{
+    assert(ina226 && compare_us);
+
+    uint32_t const cycle_us = ina226->conversion_time_us;
+    if (cycle_us == 0U || now_us < ina226->conversion_start_us + cycle_us) {
+        return INA226_ERR_FAIL;
+    }
+
+    // end of the last full conversion cycle at or before now
+    uint64_t cycle_end_us = 0U;
+    ina226_err_t const err = ina226_get_ready_time(ina226, now_us - cycle_us + 1U, &cycle_end_us);
+    if (err != INA226_ERR_OK) {
+        return err;
+    }
+
+    // bus and power are compared at the end of a cycle, the shunt voltage right after its own
+    // conversion, which comes first within the cycle
+    if (!ina226_alert_is_shunt(function) || ina226->config_reg.mode != INA226_OPERATING_MODE_SHUNT_BUS_CONTINUOUS) {
+        *compare_us = cycle_end_us;
+        return INA226_ERR_OK;
+    }
+
+    uint32_t const shunt_us = ina226_avg_to_samples((ina226_avg_t)ina226->config_reg.avg) *
+                              ina226_vsh_ct_to_conversion_time_us((ina226_vsh_ct_t)ina226->config_reg.vsh_ct);
+    uint64_t const next_shunt_us = cycle_end_us + shunt_us;
+
+    *compare_us = next_shunt_us <= now_us ? next_shunt_us : cycle_end_us - (cycle_us - shunt_us);
+
+    return INA226_ERR_OK;
+}
@@ -1,14 +1,40 @@
 #ifndef INA226_INA226_CONFIG_H
 #define INA226_INA226_CONFIG_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #define PACKED __attribute__((packed))
 
 #define INA226_MANUFACTURER_ID 0b0101010001001001
-#define INA226_BUS_VOLTAGE_SCALE 41.0F / (float32_t)(1U << 15U)
-#define INA226_SHUNT_VOLTAGE_SCALE 41.0F / (float32_t)(1U << 15U)
+// fixed LSBs of the voltage registers, 1.25 mV and 2.5 uV
+#define INA226_BUS_VOLTAGE_SCALE 1.25e-3F
+#define INA226_SHUNT_VOLTAGE_SCALE 2.5e-6F
+#define INA226_ALERT_TIMEOUT_MARGIN_US 1000U
+
+// MASK_ENABLE: one alert function at a time, polarity and latch; the flags in between are read-only
+#define INA226_MASK_ENABLE_SOL (1U << 15U)
+#define INA226_MASK_ENABLE_SUL (1U << 14U)
+#define INA226_MASK_ENABLE_BOL (1U << 13U)
+#define INA226_MASK_ENABLE_BUL (1U << 12U)
+#define INA226_MASK_ENABLE_POL (1U << 11U)
+#define INA226_MASK_ENABLE_CNVR (1U << 10U)
+#define INA226_MASK_ENABLE_AFF (1U << 4U)
+#define INA226_MASK_ENABLE_CVRF (1U << 3U)
+#define INA226_MASK_ENABLE_OVF (1U << 2U)
+#define INA226_MASK_ENABLE_APOL (1U << 1U)
+#define INA226_MASK_ENABLE_LEN (1U << 0U)
+#define INA226_MASK_ENABLE_WRITABLE                                                              \
+    (INA226_MASK_ENABLE_SOL | INA226_MASK_ENABLE_SUL | INA226_MASK_ENABLE_BOL |                  \
+     INA226_MASK_ENABLE_BUL | INA226_MASK_ENABLE_POL | INA226_MASK_ENABLE_CNVR |                 \
+     INA226_MASK_ENABLE_APOL | INA226_MASK_ENABLE_LEN)
+
+// CONFIG image with the reserved D14 set, as the device reads it back; usable in constant
+// initializers, so profiles can be built at compile time
+#define INA226_CONFIG_WORD(avg, vbus_ct, vsh_ct, mode)                                            \
+    ((uint16_t)(0x4000U | (((avg) & 0x07U) << 9U) | (((vbus_ct) & 0x07U) << 6U) |                 \
+                (((vsh_ct) & 0x07U) << 3U) | ((mode) & 0x07U)))
 
 typedef float float32_t;
 
@@ -98,14 +124,170 @@ typedef struct {
     float32_t calibration;
 } ina226_config_t;
 
+typedef struct {
+    int16_t shunt_voltage;
+    int16_t bus_voltage;
+    int16_t current;
+    int16_t power;
+    bool is_conversion_ready;
+} ina226_snapshot_t;
+
+typedef enum {
+    INA226_SHADOW_CONFIG = 1 << 0,
+    INA226_SHADOW_CALIBRATION = 1 << 1,
+    INA226_SHADOW_MASK_ENABLE = 1 << 2,
+    INA226_SHADOW_ALERT_LIMIT = 1 << 3,
+    INA226_SHADOW_ALL = (1 << 4) - 1,
+} ina226_shadow_t;
+
+typedef enum {
+    INA226_QUANTITY_SHUNT_VOLTAGE,
+    INA226_QUANTITY_BUS_VOLTAGE,
+    INA226_QUANTITY_POWER,
+    INA226_QUANTITY_CURRENT,
+} ina226_quantity_t;
+
+// limits are in volts, watts or amperes; the current ones are compared on the shunt voltage,
+// converted through the calibration
+typedef enum {
+    INA226_ALERT_NONE,
+    INA226_ALERT_SHUNT_OVER_VOLTAGE,
+    INA226_ALERT_SHUNT_UNDER_VOLTAGE,
+    INA226_ALERT_BUS_OVER_VOLTAGE,
+    INA226_ALERT_BUS_UNDER_VOLTAGE,
+    INA226_ALERT_POWER_OVER_LIMIT,
+    INA226_ALERT_CURRENT_OVER_LIMIT,
+    INA226_ALERT_CURRENT_UNDER_LIMIT,
+    INA226_ALERT_COUNT,
+} ina226_alert_function_t;
+
+typedef struct {
+    ina226_alert_function_t function;
+    float32_t limit;
+    // ALERT stays asserted until MASK_ENABLE is read, otherwise it follows every conversion
+    bool is_latched;
+} ina226_alert_t;
+
+// register images as sent on the wire; the calibration has to match config.current_scale,
+// which is what the readings are converted with
+typedef struct {
+    uint16_t config;
+    uint16_t calibration;
+    uint16_t mask_enable;
+    uint16_t alert_limit;
+} ina226_profile_t;
+
 typedef struct {
     void* bus_user;
     ina226_err_t (*bus_init)(void*);
     ina226_err_t (*bus_deinit)(void*);
     ina226_err_t (*bus_write)(void*, uint8_t, uint8_t const*, size_t);
     ina226_err_t (*bus_read)(void*, uint8_t, uint8_t*, size_t);
+
+    void* timer_user;
+    ina226_err_t (*timer_get_us)(void*, uint64_t*);
+    ina226_err_t (*timer_delay_us)(void*, uint32_t);
+
+    void* alert_user;
+    ina226_err_t (*alert_wait)(void*, uint32_t);
 } ina226_interface_t;
 
+inline uint32_t ina226_vbus_ct_to_conversion_time_us(ina226_vbus_ct_t vbus_ct)
+{
+    switch (vbus_ct) {
+        case INA226_BUS_VOLTAGE_CONVERSION_TIME_140US:
+            return 140U;
+        case INA226_BUS_VOLTAGE_CONVERSION_TIME_204US:
+            return 204U;
+        case INA226_BUS_VOLTAGE_CONVERSION_TIME_332US:
+            return 332U;
+        case INA226_BUS_VOLTAGE_CONVERSION_TIME_558US:
+            return 588U;
+        case INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1:
+            return 1100U;
+        case INA226_BUS_VOLTAGE_CONVERSION_TIME_2MS116:
+            return 2116U;
+        case INA226_BUS_VOLTAGE_CONVERSION_TIME_4MS156:
+            return 4156U;
+        case INA226_BUS_VOLTAGE_CONVERSION_TIME_8MS244:
+            return 8244U;
+        default:
+            return 0U;
+    }
+}
+
+inline uint32_t ina226_vsh_ct_to_conversion_time_us(ina226_vsh_ct_t vsh_ct)
+{
+    switch (vsh_ct) {
+        case INA226_SHUNT_VOLTAGE_CONVERSION_TIME_140US:
+            return 140U;
+        case INA226_SHUNT_VOLTAGE_CONVERSION_TIME_204US:
+            return 204U;
+        case INA226_SHUNT_VOLTAGE_CONVERSION_TIME_332US:
+            return 332U;
+        case INA226_SHUNT_VOLTAGE_CONVERSION_TIME_558US:
+            return 588U;
+        case INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1:
+            return 1100U;
+        case INA226_SHUNT_VOLTAGE_CONVERSION_TIME_2MS116:
+            return 2116U;
+        case INA226_SHUNT_VOLTAGE_CONVERSION_TIME_4MS156:
+            return 4156U;
+        case INA226_SHUNT_VOLTAGE_CONVERSION_TIME_8MS244:
+            return 8244U;
+        default:
+            return 0U;
+    }
+}
+
+inline uint32_t ina226_avg_to_samples(ina226_avg_t avg)
+{
+    switch (avg) {
+        case INA226_AVERAGING_MODE_1_SAMPLE:
+            return 1U;
+        case INA226_AVERAGING_MODE_4_SAMPLES:
+            return 4U;
+        case INA226_AVERAGING_MODE_16_SAMPLES:
+            return 16U;
+        case INA226_AVERAGING_MODE_64_SAMPLES:
+            return 64U;
+        case INA226_AVERAGING_MODE_128_SAMPLES:
+            return 128U;
+        case INA226_AVERAGING_MODE_256_SAMPLES:
+            return 256U;
+        case INA226_AVERAGING_MODE_512_SAMPLES:
+            return 512U;
+        case INA226_AVERAGING_MODE_1024_SAMPLES:
+            return 1024U;
+        default:
+            return 0U;
+    }
+}
+
+// time from a CONFIG write (or the previous result) to the next result, 0 when powered down
+inline uint32_t ina226_get_conversion_time_us(ina226_avg_t avg,
+                                              ina226_vbus_ct_t vbus_ct,
+                                              ina226_vsh_ct_t vsh_ct,
+                                              ina226_mode_t mode)
+{
+    uint32_t samples = ina226_avg_to_samples(avg);
+
+    switch (mode) {
+        case INA226_OPERATING_MODE_SHUNT_TRIGGERED:
+        case INA226_OPERATING_MODE_SHUNT_CONTINUOUS:
+            return samples * ina226_vsh_ct_to_conversion_time_us(vsh_ct);
+        case INA226_OPERATING_MODE_BUS_TRIGGERED:
+        case INA226_OPERATING_MODE_BUS_CONTINUOUS:
+            return samples * ina226_vbus_ct_to_conversion_time_us(vbus_ct);
+        case INA226_OPERATING_MODE_SHUNT_BUS_TRIGGERED:
+        case INA226_OPERATING_MODE_SHUNT_BUS_CONTINUOUS:
+            return samples * (ina226_vbus_ct_to_conversion_time_us(vbus_ct) +
+                              ina226_vsh_ct_to_conversion_time_us(vsh_ct));
+        default:
+            return 0U;
+    }
+}
+
 inline float32_t ina226_current_range_to_scale(float32_t current_range)
 {
     return current_range / (float32_t)(1U << 15U);
@@ -30,7 +30,7 @@ typedef struct {
 } PACKED ina226_current_reg_t;
 
 typedef struct {
-    int16_t fs : 15;
+    uint16_t fs : 15;
 } PACKED ina226_calibration_reg_t;
 
 typedef struct {
@@ -0,0 +1,101 @@
+#include "ina226.h"
+#include <assert.h>
+#include <string.h>
+
+// one multiply per element in every variant, so all of them give bit-identical results
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define INA226_SCALE_VECTOR_WIDTH 8U
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define INA226_SCALE_VECTOR_WIDTH 4U
+#elif defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+// the M4 has no float SIMD; what pays off is fetching two readings per load and keeping the
+// FPU busy with independent conversions while the next word comes in
+#define INA226_SCALE_VECTOR_WIDTH 4U
+#else
+#define INA226_SCALE_VECTOR_WIDTH 0U
+#endif
+
+#if INA226_SCALE_VECTOR_WIDTH > 0U
+static void ina226_scale_vector(int16_t const* raw, float32_t* scaled, float32_t scale)
+{
+#if defined(__AVX2__)
+    __m128i const words = _mm_loadu_si128((__m128i const*)(void const*)raw);
+    __m256 const values = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(words));
+    _mm256_storeu_ps(scaled, _mm256_mul_ps(values, _mm256_set1_ps(scale)));
+#elif defined(__SSE2__)
+    // duplicating each word into both halves and shifting back sign-extends without SSE4.1
+    __m128i const words = _mm_loadl_epi64((__m128i const*)(void const*)raw);
+    __m128 const values = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16));
+    _mm_storeu_ps(scaled, _mm_mul_ps(values, _mm_set1_ps(scale)));
+#else
+    uint32_t words[2];
+    memcpy(words, raw, sizeof(words));
+
+    scaled[0] = (float32_t)(int16_t)words[0] * scale;
+    scaled[1] = (float32_t)(int16_t)(words[0] >> 16U) * scale;
+    scaled[2] = (float32_t)(int16_t)words[1] * scale;
+    scaled[3] = (float32_t)(int16_t)(words[1] >> 16U) * scale;
+#endif
+}
+#endif
+
+void ina226_scale_block_generic(int16_t const* raw, float32_t* scaled, size_t count, float32_t scale)
+{
+    assert((raw && scaled) || count == 0U);
+
+    for (size_t i = 0U; i < count; ++i) {
+        scaled[i] = (float32_t)raw[i] * scale;
+    }
+}
+
+void ina226_scale_block(int16_t const* raw, float32_t* scaled, size_t count, float32_t scale)
+{
+    assert((raw && scaled) || count == 0U);
+
+    size_t i = 0U;
+
+#if INA226_SCALE_VECTOR_WIDTH > 0U
+    for (; i + INA226_SCALE_VECTOR_WIDTH <= count; i += INA226_SCALE_VECTOR_WIDTH) {
+        ina226_scale_vector(&raw[i], &scaled[i], scale);
+    }
+#endif
+
+    ina226_scale_block_generic(&raw[i], &scaled[i], count - i, scale);
+}
+
+float32_t ina226_get_scale(ina226_t const* ina226, ina226_quantity_t quantity)
+{
+    assert(ina226);
+
+    switch (quantity) {
+        case INA226_QUANTITY_SHUNT_VOLTAGE:
+            return INA226_SHUNT_VOLTAGE_SCALE;
+        case INA226_QUANTITY_BUS_VOLTAGE:
+            return INA226_BUS_VOLTAGE_SCALE;
+        case INA226_QUANTITY_POWER:
+            return ina226_current_to_power_scale(ina226->config.current_scale);
+        case INA226_QUANTITY_CURRENT:
+            return ina226->config.current_scale;
+        default:
+            return 0.0F;
+    }
+}
+
+ina226_err_t ina226_scale_quantity_block(ina226_t const* ina226,
+                                         ina226_quantity_t quantity,
+                                         int16_t const* raw,
+                                         float32_t* scaled,
+                                         size_t count)
+{
+    assert(ina226);
+
+    if (quantity > INA226_QUANTITY_CURRENT) {
+        return INA226_ERR_FAIL;
+    }
+
+    ina226_scale_block(raw, scaled, count, ina226_get_scale(ina226, quantity));
+
+    return INA226_ERR_OK;
+}
@@ -0,0 +1,125 @@
+#include "deferred_logger.hpp"
+#include "memory_sections.h"
+
+namespace logger {
+
+    namespace {
+
+        constexpr std::uint32_t BUFFER_MASK = BUFFER_WORDS - 1U;
+
+    } // namespace
+
+    MEMORY_RAMFUNC bool deferred_logger::write_words(std::uint16_t id, std::uint32_t const* args, std::size_t count) noexcept
+    {
+        if (count > MAX_ARG_WORDS) {
+            dropped_.fetch_add(1U, std::memory_order_relaxed);
+            return false;
+        }
+
+        auto const words = static_cast<std::uint32_t>(RECORD_HEADER_WORDS + count);
+
+        std::uint32_t write = write_.load(std::memory_order_relaxed);
+        do {
+            if (write - read_.load(std::memory_order_acquire) + words > BUFFER_WORDS) {
+                dropped_.fetch_add(1U, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!write_.compare_exchange_weak(write, write + words, std::memory_order_relaxed));
+
+        std::uint32_t const timestamp = interface_.get_timestamp != nullptr ? interface_.get_timestamp(interface_.user) : 0U;
+        buffer_[(write + 1U) & BUFFER_MASK].store(timestamp, std::memory_order_relaxed);
+        for (std::size_t i = 0U; i < count; ++i) {
+            buffer_[(write + RECORD_HEADER_WORDS + i) & BUFFER_MASK].store(args[i], std::memory_order_relaxed);
+        }
+
+        buffer_[write & BUFFER_MASK].store(HEADER_COMMITTED | (static_cast<std::uint32_t>(count) << HEADER_COUNT_SHIFT) | id,
+                                           std::memory_order_release);
+        records_.fetch_add(1U, std::memory_order_relaxed);
+
+        if (interface_.wake != nullptr) {
+            interface_.wake(interface_.user);
+        }
+
+        return true;
+    }
+
+    std::size_t deferred_logger::drain(std::uint8_t* out, std::size_t size) noexcept
+    {
+        std::uint32_t read = read_.load(std::memory_order_relaxed);
+
+        std::size_t const pending = write_.load(std::memory_order_relaxed) - read;
+        if (pending > high_water_words_) {
+            high_water_words_ = pending;
+        }
+
+        std::size_t used = 0U;
+        while (size - used >= MAX_FRAME_SIZE) {
+            std::uint32_t const header = buffer_[read & BUFFER_MASK].load(std::memory_order_acquire);
+            if ((header & HEADER_COMMITTED) == 0U) {
+                break;
+            }
+
+            std::size_t const words = RECORD_HEADER_WORDS + ((header >> HEADER_COUNT_SHIFT) & HEADER_COUNT_MASK);
+            std::array<std::uint32_t, MAX_RECORD_WORDS> record;
+            for (std::size_t i = 0U; i < words; ++i) {
+                // cleared, so a later reservation over these words cannot pass for a committed header
+                record[i] = buffer_[(read + i) & BUFFER_MASK].exchange(0U, std::memory_order_relaxed);
+            }
+
+            read += static_cast<std::uint32_t>(words);
+            read_.store(read, std::memory_order_release);
+
+            used += encode(record.data(), words, out + used);
+        }
+
+        return used;
+    }
+
+    bool deferred_logger::is_empty() const noexcept
+    {
+        return read_.load(std::memory_order_relaxed) == write_.load(std::memory_order_relaxed);
+    }
+
+    logger_stats deferred_logger::get_stats() const noexcept
+    {
+        return {.records = records_.load(std::memory_order_relaxed),
+                .dropped = dropped_.load(std::memory_order_relaxed),
+                .high_water_words = high_water_words_};
+    }
+
+    void deferred_logger::reset_stats() noexcept
+    {
+        records_.store(0U, std::memory_order_relaxed);
+        dropped_.store(0U, std::memory_order_relaxed);
+        high_water_words_ = 0U;
+    }
+
+    std::size_t deferred_logger::encode(std::uint32_t const* words, std::size_t count, std::uint8_t* out) noexcept
+    {
+        // consistent overhead byte stuffing: every zero is replaced by the distance to the next
+        // one, so the frame itself never contains the zero delimiter
+        std::size_t code_index = 0U;
+        std::size_t used = 1U;
+        std::uint8_t code = 1U;
+
+        for (std::size_t i = 0U; i < count * 4U; ++i) {
+            auto const byte = static_cast<std::uint8_t>(words[i / 4U] >> (8U * (i % 4U)));
+
+            if (byte != 0U) {
+                out[used++] = byte;
+                ++code;
+            }
+            if (byte == 0U || code == 0xFFU) {
+                out[code_index] = code;
+                code_index = used++;
+                code = 1U;
+            }
+        }
+
+        out[code_index] = code;
+        out[used++] = 0U;
+
+        return used;
+    }
+
+} // namespace logger
@@ -0,0 +1,107 @@
+#ifndef LOGGER_DEFERRED_LOGGER_HPP
+#define LOGGER_DEFERRED_LOGGER_HPP
+
+#include "logger_config.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// the format string never reaches flash: it lives in the non-loaded logger_fmt section placed at
+// address 0, so its address is the id the host tool looks up in the ELF
+#define LOGGER_WRITE(log, format, ...)                                                               \
+    do {                                                                                             \
+        [[gnu::section("logger_fmt"), gnu::used]] static constexpr char logger_format_[] = format;   \
+        (log).write(::logger::format_id(logger_format_) __VA_OPT__(, ) __VA_ARGS__);                  \
+    } while (false)
+
+namespace logger {
+
+    inline std::uint16_t format_id(char const* format) noexcept
+    {
+        return static_cast<std::uint16_t>(reinterpret_cast<std::uintptr_t>(format));
+    }
+
+    template <typename T>
+    consteval std::size_t arg_words() noexcept
+    {
+        return sizeof(T) > sizeof(std::uint32_t) && !std::is_floating_point_v<T> ? 2U : 1U;
+    }
+
+    // integers are stored sign-extended to 32 bits (two words, low first, when wider), floating
+    // point as float bits and pointers as their address, so %s can be resolved from the ELF
+    template <typename T>
+    void pack_arg(std::uint32_t*& words, T value) noexcept
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            *words++ = std::bit_cast<std::uint32_t>(static_cast<float>(value));
+        } else if constexpr (std::is_pointer_v<T>) {
+            *words++ = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(value));
+        } else if constexpr (std::is_enum_v<T>) {
+            *words++ = static_cast<std::uint32_t>(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (sizeof(T) > sizeof(std::uint32_t)) {
+            auto const wide = static_cast<std::uint64_t>(value);
+            *words++ = static_cast<std::uint32_t>(wide);
+            *words++ = static_cast<std::uint32_t>(wide >> 32U);
+        } else {
+            *words++ = static_cast<std::uint32_t>(value);
+        }
+    }
+
+    // multi-producer ring of word records: writers from any context reserve with a single
+    // compare-and-swap and commit by storing the header last, one consumer drains in order;
+    // a writer preempted between reserve and commit holds back the records behind it
+    class deferred_logger {
+    public:
+        explicit constexpr deferred_logger(logger_interface const& interface) noexcept :
+            interface_{interface}
+        {}
+
+        deferred_logger(deferred_logger const&) = delete;
+        deferred_logger& operator=(deferred_logger const&) = delete;
+
+        template <typename... Args>
+        bool write(std::uint16_t id, Args... args) noexcept
+        {
+            constexpr std::size_t count = (arg_words<Args>() + ... + 0U);
+            static_assert(count <= MAX_ARG_WORDS);
+
+            std::array<std::uint32_t, count> words;
+            [[maybe_unused]] std::uint32_t* cursor = words.data();
+            (pack_arg(cursor, args), ...);
+
+            return write_words(id, words.data(), count);
+        }
+
+        // stores the words as they are, at most MAX_ARG_WORDS of them; meant for RAW_ID_FIRST
+        // and up, where no format string describes the layout
+        bool write_words(std::uint16_t id, std::uint32_t const* args, std::size_t count) noexcept;
+
+        // encodes committed records as COBS frames, each terminated by a zero byte; stops at the
+        // first record that does not fit and returns the number of bytes written
+        [[nodiscard]] std::size_t drain(std::uint8_t* out, std::size_t size) noexcept;
+
+        [[nodiscard]] bool is_empty() const noexcept;
+
+        [[nodiscard]] logger_stats get_stats() const noexcept;
+        void reset_stats() noexcept;
+
+    private:
+        static std::size_t encode(std::uint32_t const* words, std::size_t count, std::uint8_t* out) noexcept;
+
+        logger_interface interface_;
+
+        std::array<std::atomic<std::uint32_t>, BUFFER_WORDS> buffer_{};
+        std::atomic<std::uint32_t> write_{0U};
+        std::atomic<std::uint32_t> read_{0U};
+
+        std::atomic<std::uint32_t> records_{0U};
+        std::atomic<std::uint32_t> dropped_{0U};
+        std::size_t high_water_words_{0U};
+    };
+
+} // namespace logger
+
+#endif // LOGGER_DEFERRED_LOGGER_HPP
@@ -0,0 +1,59 @@
+#ifndef LOGGER_LOGGER_CONFIG_HPP
+#define LOGGER_LOGGER_CONFIG_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace logger {
+
+    // ring capacity in 32-bit words, a power of two so the free-running indices wrap without a modulo
+    inline constexpr std::size_t BUFFER_WORDS = 512U;
+    static_assert((BUFFER_WORDS & (BUFFER_WORDS - 1U)) == 0U);
+
+    // one argument word per value up to 32 bits, two for 64-bit values
+    inline constexpr std::size_t MAX_ARG_WORDS = 15U;
+
+    // header and timestamp
+    inline constexpr std::size_t RECORD_HEADER_WORDS = 2U;
+    inline constexpr std::size_t MAX_RECORD_WORDS = RECORD_HEADER_WORDS + MAX_ARG_WORDS;
+
+    // COBS adds one byte per started 254 and the frame delimiter
+    inline constexpr std::size_t MAX_FRAME_SIZE = MAX_RECORD_WORDS * 4U + (MAX_RECORD_WORDS * 4U) / 254U + 2U;
+
+    // header word: bit 31 marks a committed record, bits 16..19 the argument word count and
+    // bits 0..15 the format id
+    inline constexpr std::uint32_t HEADER_COMMITTED = 1UL << 31U;
+    inline constexpr std::uint32_t HEADER_COUNT_SHIFT = 16U;
+    inline constexpr std::uint32_t HEADER_COUNT_MASK = 0xFUL;
+    inline constexpr std::uint32_t HEADER_ID_MASK = 0xFFFFUL;
+
+    // ids from here up never name a format string, the records carry words for another host
+    // tool (command responses, captures) and the decoder passes them through; the linker script
+    // asserts the format section stays below
+    inline constexpr std::uint16_t RAW_ID_FIRST = 0xFF00U;
+
+    enum struct err : std::uint8_t {
+        ok = 0,
+        fail = 1 << 0,
+        null = 1 << 1,
+        capacity = 1 << 2,
+    };
+
+    struct logger_interface {
+        void* user;
+        // timestamp stored with every record, typically the DWT cycle counter
+        std::uint32_t (*get_timestamp)(void*);
+        // optional, called after every committed record, so the drain can be scheduled;
+        // runs in the context of the writer, including interrupts
+        void (*wake)(void*);
+    };
+
+    struct logger_stats {
+        std::uint32_t records;
+        std::uint32_t dropped;
+        std::size_t high_water_words;
+    };
+
+} // namespace logger
+
+#endif // LOGGER_LOGGER_CONFIG_HPP
@@ -0,0 +1,107 @@
+#ifndef MAIN_APP_HPP
+#define MAIN_APP_HPP
+
+#include "app_config.hpp"
+#include "arena.hpp"
+#include "deferred_logger.hpp"
+#include "executor.hpp"
+#include "i2c_transport.hpp"
+#include "main.h"
+#include "pipeline.hpp"
+
+extern "C" {
+#include "acquisition.h"
+#include "adaptive.h"
+#include "alert.h"
+#include "bus_scheduler.h"
+#include "capture.h"
+#include "command.h"
+#include "decimator.h"
+#include "histogram.h"
+#include "runtime.h"
+#include "sampler.h"
+#include "segmenter.h"
+#include "transient.h"
+}
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// the application state is defined in main.cpp next to the interrupt and HAL glue; the record
+// streams, the telemetry and the command app ops each live in their own file and reach it here
+namespace app {
+
+    extern ina226_t ina226;
+    extern std::array<ina226_profile_t, PROFILE_COUNT> profiles;
+    extern adaptive_t adaptive;
+    extern acquisition_t acquisition;
+    extern acquisition_mode_t acquisition_mode;
+    extern trigger_stats_t trigger_stats;
+    extern bus_scheduler_t bus_scheduler;
+    extern std::size_t bus_channel;
+    extern sampler_t sampler;
+    extern runtime_t runtime;
+
+    extern std::size_t acquisition_task;
+    extern std::size_t processing_task;
+    extern std::size_t telemetry_task;
+    extern std::size_t command_task;
+    extern std::size_t log_task;
+    extern std::size_t capture_task;
+    extern std::size_t histogram_task;
+
+    extern std::array<channel_stats_t, ACQUISITION_MAX_DEVICES> channel_stats;
+    extern std::array<shunt_filter_t, ACQUISITION_MAX_DEVICES> shunt_filters;
+    extern std::array<decimator_t, ACQUISITION_MAX_DEVICES> shunt_decimators;
+    extern std::array<transient_t, ACQUISITION_MAX_DEVICES> transients;
+    extern bool is_transient_enabled;
+
+    extern histogram_t shunt_histogram;
+    extern histogram_t histogram_snapshot;
+    extern histogram_stream_t histogram_stream;
+
+    extern segmenter_t segmenter;
+    extern bool is_segmenter_enabled;
+    extern std::array<std::int16_t, SEGMENTER_MAX_STATES - 1U> segment_thresholds;
+    extern std::size_t segment_threshold_count;
+    extern std::uint32_t shunt_filter_max_cycles;
+
+    extern capture_t capture;
+    extern capture_stream_t capture_stream;
+    extern std::uint32_t alerts;
+
+    extern alert_t alert;
+    extern ina226_alert_t alert_setting;
+    extern std::uint32_t alert_limit_bits;
+    extern bool is_alert_acknowledge_pending;
+
+    extern std::array<isr_profile_stats_t, ISR_PROFILE_COUNT> isr_profiles;
+    extern std::uint32_t sampler_overruns;
+
+    extern logger::deferred_logger event_log;
+    extern memory::static_arena<INIT_ARENA_SIZE> init_arena;
+    extern char const* volatile memory_failure_name;
+    extern volatile std::uint32_t memory_failures;
+
+    extern async::executor executor;
+    extern async::i2c_transport i2c1_bus;
+    extern async::pipeline acquisition_pipeline;
+
+    // records.cpp: the event, segment, capture and histogram streams as raw log records
+    void transient_send(std::size_t channel);
+    void segments_send();
+    runtime_err_t capture_task_handler(void*, std::uint32_t);
+    runtime_err_t histogram_task_handler(void*, std::uint32_t);
+
+    // telemetry.cpp: the once-a-second summary lines
+    runtime_err_t telemetry_task_handler(void*, std::uint32_t);
+
+    // app_ops.cpp: the ops past COMMAND_APP_OP_FIRST, and the setups startup shares with them
+    command_status_t command_app_op(void*, std::uint8_t op, std::uint16_t value, std::uint16_t*);
+    void shunt_filters_initialize();
+    bool decimators_initialize(std::uint32_t ratio);
+
+} // namespace app
+
+#endif // MAIN_APP_HPP
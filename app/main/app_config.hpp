@@ -0,0 +1,207 @@
+#ifndef MAIN_APP_CONFIG_HPP
+#define MAIN_APP_CONFIG_HPP
+
+#include "deferred_logger.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+#include "filter.h"
+#include "ina226.h"
+}
+
+namespace app {
+
+    inline constexpr std::uint32_t SAMPLE_PERIOD_US = 1000U;
+    inline constexpr std::uint32_t TELEMETRY_PERIOD_US = 1000000U;
+    inline constexpr std::uint32_t I2C_TIMEOUT_MS = 10U;
+    // Timing 0x10D19CE4 at 80 MHz; the overhead covers the interrupt and HAL setup per transfer
+    inline constexpr std::uint32_t I2C1_FREQUENCY_HZ = 100000U;
+    inline constexpr std::uint32_t I2C1_TRANSACTION_OVERHEAD_NS = 10000U;
+    // shunt, bus, power and current per block
+    inline constexpr std::uint8_t PIPELINE_READS_PER_SAMPLE = 4U;
+
+    inline constexpr float32_t CURRENT_RANGE_A = 1.0F;
+    inline constexpr float32_t SHUNT_RESISTANCE_OHM = 0.1F;
+
+    inline constexpr std::uint32_t EVENT_ASYNC = 1U << 0U;
+    inline constexpr std::uint32_t EVENT_ALERT = 1U << 1U;
+    inline constexpr std::uint32_t EVENT_DATA = 1U << 0U;
+    inline constexpr std::uint32_t EVENT_TELEMETRY = 1U << 0U;
+    inline constexpr std::uint32_t EVENT_COMMAND = 1U << 0U;
+    inline constexpr std::uint32_t EVENT_COMMAND_RX_STOPPED = 1U << 1U;
+    inline constexpr std::uint32_t EVENT_LOG = 1U << 0U;
+    inline constexpr std::uint32_t EVENT_CAPTURE = 1U << 0U;
+    inline constexpr std::uint32_t EVENT_HISTOGRAM = 1U << 0U;
+
+    // circular DMA target; the task has to catch up before the receiver laps it, which a few
+    // requests per sample period cannot do
+    inline constexpr std::uint16_t COMMAND_RX_BUFFER_SIZE = 128U;
+    inline constexpr std::uint16_t COMMAND_RESPONSE_ID = logger::RAW_ID_FIRST;
+
+    // scope mode on the raw shunt readings of one channel, half a second around the trigger
+    inline constexpr std::size_t CAPTURE_CHANNEL = 0U;
+    inline constexpr std::size_t CAPTURE_PRE_SAMPLES = 256U;
+    inline constexpr std::size_t CAPTURE_POST_SAMPLES = 256U;
+    // a frozen window goes out as raw records: one header (kind 0 | source << 16 | sequence,
+    // pre count | count << 16, trigger time low and high word), then data records (kind 1 |
+    // sequence, offset | samples << 16, two samples per word, the earlier one in the low half)
+    inline constexpr std::uint16_t CAPTURE_RECORD_ID = logger::RAW_ID_FIRST + 1U;
+    inline constexpr std::uint32_t CAPTURE_RECORD_HEADER = 0U;
+    inline constexpr std::uint32_t CAPTURE_RECORD_DATA = 1U;
+    inline constexpr std::size_t CAPTURE_SAMPLES_PER_RECORD = (logger::MAX_ARG_WORDS - 2U) * 2U;
+    inline constexpr std::size_t CAPTURE_RECORDS_PER_RUN = 2U;
+
+    // SET_ALERT value: the ina226_alert_function_t in the low byte, this bit for latch mode
+    inline constexpr std::uint16_t ALERT_LATCH_FLAG = 1U << 8U;
+    // the pin interrupts on both edges now; edges closer than this are chatter, and more than
+    // ALERT_RATE_MAX_EDGES per window mask the pin for the rest of it
+    inline constexpr std::uint32_t ALERT_CHATTER_US = 1000U;
+    inline constexpr std::uint32_t ALERT_RATE_WINDOW_US = 100000U;
+    inline constexpr std::uint32_t ALERT_RATE_MAX_EDGES = 16U;
+
+    // event mode: instead of the decimated shunt lines every channel sends its bursts as event
+    // records and the quiet stretches as one summary a second. An event record is kind 0 |
+    // channel << 16, start time low and high word, duration in us, samples, peak | baseline
+    // << 16, peak offset, area low and high word (int64, LSB us) and the charge in nC as
+    // float32 bits; a summary is kind 1 | channel << 16, end time low and high word, samples,
+    // quiet samples, min | max << 16, baseline, quiet mean in LSBs as float32 bits and events
+    inline constexpr std::uint16_t TRANSIENT_RECORD_ID = logger::RAW_ID_FIRST + 2U;
+    inline constexpr std::uint32_t TRANSIENT_RECORD_EVENT = 0U;
+    inline constexpr std::uint32_t TRANSIENT_RECORD_SUMMARY = 1U;
+    inline constexpr std::uint32_t TRANSIENT_HOLD_SAMPLES = 8U;
+    inline constexpr std::uint32_t TRANSIENT_MAX_SAMPLES = 10000U;
+    inline constexpr std::uint32_t TRANSIENT_BASELINE_SHIFT = 8U;
+    inline constexpr std::uint32_t TRANSIENT_SUMMARY_SAMPLES = 1000U;
+
+    // power states of one channel: its shunt readings are split into runs of one state each,
+    // and every closed run goes out as a raw record: state | sequence << 16, start time low and
+    // high word, duration in us, samples, min | max << 16, then charge in C and energy in J as
+    // float32 bits
+    inline constexpr std::uint16_t SEGMENT_RECORD_ID = logger::RAW_ID_FIRST + 3U;
+    inline constexpr std::size_t SEGMENTER_CHANNEL = 0U;
+    inline constexpr std::uint32_t SEGMENTER_DWELL_SAMPLES = 5U;
+    // sleep, idle, active and transmit, split at 1 mA, 20 mA and 100 mA through 0.1 Ohm
+    inline constexpr std::array<std::int16_t, 3U> SEGMENTER_DEFAULT_THRESHOLDS{40, 800, 4000};
+
+    // tail statistics of the raw shunt readings of one channel, kept on the device; a dump
+    // freezes a snapshot and sends it as raw records: a header (kind 0 | sub-bucket bits << 16
+    // | sequence, total low and high word, min | max << 16, sum low and high word, start and
+    // end time low and high words, non-empty buckets), then data records (kind 1 | sequence,
+    // then bucket index and count pairs of the non-empty buckets in index order)
+    inline constexpr std::uint16_t HISTOGRAM_RECORD_ID = logger::RAW_ID_FIRST + 4U;
+    inline constexpr std::size_t HISTOGRAM_CHANNEL = 0U;
+    inline constexpr std::uint32_t HISTOGRAM_RECORD_HEADER = 0U;
+    inline constexpr std::uint32_t HISTOGRAM_RECORD_DATA = 1U;
+    inline constexpr std::size_t HISTOGRAM_PAIRS_PER_RECORD = (logger::MAX_ARG_WORDS - 1U) / 2U;
+    inline constexpr std::size_t HISTOGRAM_RECORDS_PER_RUN = 2U;
+    // DUMP_HISTOGRAM value: start over once the snapshot is taken
+    inline constexpr std::uint16_t HISTOGRAM_RESET_FLAG = 1U << 0U;
+
+    // named register sets for ina226_apply_profile; switching only writes what differs
+    enum profile_t : std::uint8_t {
+        PROFILE_DEFAULT,
+        PROFILE_HIGH_BANDWIDTH,
+        PROFILE_LOW_NOISE,
+        PROFILE_COUNT,
+    };
+
+    inline constexpr std::array<std::uint16_t, PROFILE_COUNT> PROFILE_CONFIG_WORDS{
+        INA226_CONFIG_WORD(INA226_AVERAGING_MODE_1_SAMPLE,
+                           INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+                           INA226_SHUNT_VOLTAGE_CONVERSION_TIME_1MS1,
+                           INA226_OPERATING_MODE_SHUNT_BUS_CONTINUOUS),
+        INA226_CONFIG_WORD(INA226_AVERAGING_MODE_1_SAMPLE,
+                           INA226_BUS_VOLTAGE_CONVERSION_TIME_140US,
+                           INA226_SHUNT_VOLTAGE_CONVERSION_TIME_204US,
+                           INA226_OPERATING_MODE_SHUNT_BUS_CONTINUOUS),
+        INA226_CONFIG_WORD(INA226_AVERAGING_MODE_16_SAMPLES,
+                           INA226_BUS_VOLTAGE_CONVERSION_TIME_1MS1,
+                           INA226_SHUNT_VOLTAGE_CONVERSION_TIME_2MS116,
+                           INA226_OPERATING_MODE_SHUNT_BUS_CONTINUOUS)};
+
+    // results have to keep up with this much signal bandwidth, the controller trades whatever
+    // is left for averaging; 0 keeps the static profile
+    inline constexpr std::uint32_t ADAPTIVE_BANDWIDTH_HZ = 50U;
+    inline constexpr std::uint32_t ADAPTIVE_WINDOW = 32U;
+    // typical current noise at 1.1 ms shunt conversion, in current LSBs
+    inline constexpr float32_t ADAPTIVE_NOISE_LSB = 1.0F;
+
+    // software oversampling of the raw shunt readings past the 1024-sample hardware average;
+    // ratio^order has to stay a power of two for the integer conversion to nanovolts
+    inline constexpr std::uint32_t DECIMATOR_ORDER = 2U;
+    inline constexpr std::uint32_t DECIMATOR_RATIO = 256U;
+    inline constexpr std::uint32_t DECIMATOR_MAX_RATIO = 4096U;
+    inline constexpr std::int64_t SHUNT_LSB_NV = 2500;
+
+    // raw shunt readings are filtered in blocks of this many before they reach the decimator
+    inline constexpr std::size_t SHUNT_FILTER_BLOCK = 16U;
+    // anti-alias low-pass, Hamming-windowed sinc with the cutoff at a tenth of the sample rate,
+    // Q15 with a DC gain just under 1
+    inline constexpr std::array<std::int16_t, 16U> SHUNT_FIR_TAPS{
+        -114, -159, -139, 291, 1450, 3284, 5246, 6524, 6524, 5246, 3284, 1450, 291, -139, -159, -114};
+    // 50 Hz mains notch with Q = 5 at the 1 kHz sample rate, Q2.14
+    inline constexpr filter_biquad_section_t SHUNT_NOTCH{.b0 = 15893, .b1 = -30230, .b2 = 15893, .a1 = -30230, .a2 = 15402};
+
+    inline constexpr std::size_t INIT_ARENA_SIZE = 512U;
+    inline constexpr std::size_t LOG_TX_BUFFER_SIZE = 256U;
+
+    enum struct acquisition_mode_t : std::uint8_t {
+        // the devices convert on their own, blocks pick up whatever conversion finished last
+        continuous,
+        // every block triggers all devices back to back and reads them in ready-time order,
+        // so the readings of one block are aligned to within the reported skew
+        triggered,
+    };
+
+    struct trigger_stats_t {
+        std::uint32_t batches;
+        std::uint32_t errors;
+        std::uint64_t skew_sum_us;
+        std::uint32_t max_skew_us;
+    };
+
+    struct channel_stats_t {
+        std::uint32_t count;
+        std::uint32_t errors;
+        float32_t bus_voltage_sum;
+        float32_t current_sum;
+        float32_t current_min;
+        float32_t current_max;
+        float32_t power_sum;
+        // over the anti-aliased shunt readings, so single noisy results do not set them
+        float32_t filtered_shunt_min;
+        float32_t filtered_shunt_max;
+        std::uint32_t filtered_blocks;
+    };
+
+    struct shunt_filter_t {
+        std::array<std::int16_t, SHUNT_FILTER_BLOCK> block;
+        std::size_t count;
+        filter_fir_t fir;
+        filter_biquad_t notch;
+    };
+
+    struct histogram_stream_t {
+        bool is_active;
+        bool is_header_sent;
+        std::size_t index;
+        std::uint32_t sequence;
+    };
+
+    struct capture_stream_t {
+        bool is_active;
+        bool is_header_sent;
+        std::size_t offset;
+    };
+
+    struct isr_profile_stats_t {
+        std::uint32_t count;
+        std::uint32_t max_cycles;
+        std::uint32_t total_cycles;
+    };
+
+} // namespace app
+
+#endif // MAIN_APP_CONFIG_HPP
@@ -0,0 +1,329 @@
+#include "app.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+
+namespace app {
+
+    namespace {
+
+        command_status_t histogram_dump(std::uint16_t flags)
+        {
+            if (histogram_stream.is_active) {
+                return COMMAND_STATUS_BUSY;
+            }
+
+            histogram_snapshot = shunt_histogram;
+            if (flags & HISTOGRAM_RESET_FLAG) {
+                histogram_reset(&shunt_histogram);
+            }
+            histogram_stream = {.is_active = true,
+                                .is_header_sent = false,
+                                .index = 0U,
+                                .sequence = histogram_stream.sequence + 1U};
+            runtime_set_events(&runtime, histogram_task, EVENT_HISTOGRAM);
+
+            return COMMAND_STATUS_OK;
+        }
+
+        // the profiles carry the alert words too, so switching profiles keeps the limit
+        command_status_t alert_apply(ina226_alert_t const& setting)
+        {
+            std::uint16_t mask_enable{};
+            std::uint16_t alert_limit{};
+            if (ina226_alert_to_words(&ina226, &setting, &mask_enable, &alert_limit) != INA226_ERR_OK) {
+                return COMMAND_STATUS_BAD_VALUE;
+            }
+            if (ina226_set_alert(&ina226, &setting) != INA226_ERR_OK) {
+                return COMMAND_STATUS_BUS_FAIL;
+            }
+
+            for (auto& profile : profiles) {
+                profile.mask_enable = mask_enable;
+                profile.alert_limit = alert_limit;
+            }
+            alert_setting = setting;
+            is_alert_acknowledge_pending = false;
+            alert_clear_hysteresis(&alert);
+
+            return COMMAND_STATUS_OK;
+        }
+
+        // the release limit comes from the float set by the limit ops; it has to sit on the
+        // inactive side of the trigger limit, and a latched pin would never show the release
+        command_status_t alert_hysteresis_apply(bool is_enabled, float32_t release_limit)
+        {
+            if (!is_enabled) {
+                alert_clear_hysteresis(&alert);
+                return ina226_update_alert_limit(&ina226, profiles[PROFILE_DEFAULT].alert_limit) == INA226_ERR_OK
+                           ? COMMAND_STATUS_OK
+                           : COMMAND_STATUS_BUS_FAIL;
+            }
+            if (alert_setting.function == INA226_ALERT_NONE || alert_setting.is_latched) {
+                return COMMAND_STATUS_BAD_VALUE;
+            }
+
+            bool const is_under = alert_setting.function == INA226_ALERT_SHUNT_UNDER_VOLTAGE ||
+                                  alert_setting.function == INA226_ALERT_BUS_UNDER_VOLTAGE ||
+                                  alert_setting.function == INA226_ALERT_CURRENT_UNDER_LIMIT;
+            if (is_under ? release_limit <= alert_setting.limit : release_limit >= alert_setting.limit) {
+                return COMMAND_STATUS_BAD_VALUE;
+            }
+
+            ina226_alert_t const release{.function = alert_setting.function, .limit = release_limit, .is_latched = false};
+            std::uint16_t mask_enable{};
+            std::uint16_t release_word{};
+            if (ina226_alert_to_words(&ina226, &release, &mask_enable, &release_word) != INA226_ERR_OK) {
+                return COMMAND_STATUS_BAD_VALUE;
+            }
+
+            // the device holds the trigger limit from alert_apply; the next block moves it if the
+            // pin is already asserted
+            alert_set_hysteresis(&alert, profiles[PROFILE_DEFAULT].alert_limit, release_word);
+
+            return COMMAND_STATUS_OK;
+        }
+
+        // 0 leaves only the ALERT pin as trigger, whatever limit the mask and alert limit ops set
+        command_status_t capture_start(std::int16_t threshold)
+        {
+            if (capture_stream.is_active) {
+                return COMMAND_STATUS_BUSY;
+            }
+
+            capture_config_t const config{.pre_samples = CAPTURE_PRE_SAMPLES,
+                                          .post_samples = CAPTURE_POST_SAMPLES,
+                                          .is_threshold_enabled = threshold != 0,
+                                          .threshold = threshold};
+            if (capture_initialize(&capture, &config) != CAPTURE_ERR_OK) {
+                return COMMAND_STATUS_BAD_VALUE;
+            }
+            capture_arm(&capture);
+
+            return COMMAND_STATUS_OK;
+        }
+
+        void command_reset_counters()
+        {
+            for (std::size_t i = 0U; i < runtime.task_count; ++i) {
+                runtime.tasks[i].runs = 0U;
+                runtime.tasks[i].errors = 0U;
+                runtime.tasks[i].max_cycles = 0U;
+                runtime.tasks[i].total_cycles = 0U;
+            }
+            runtime.idle_runs = 0U;
+            runtime.idle_cycles = 0U;
+            sampler.max_latency_us = 0U;
+            isr_profiles = {};
+            capture.captures = 0U;
+            capture.missed_triggers = 0U;
+            alert_reset_stats(&alert);
+            for (auto& transient : transients) {
+                transient.events = 0U;
+                transient.dropped = 0U;
+            }
+            segmenter.dropped = 0U;
+            std::fill(std::begin(segmenter.residency_us), std::end(segmenter.residency_us), 0U);
+            for (auto& filter : shunt_filters) {
+                filter.fir.saturations = 0U;
+                filter.notch.saturations = 0U;
+            }
+            acquisition_reset_counters(&acquisition);
+            trigger_stats = {};
+        }
+
+        // threshold in shunt LSBs, 0 goes back to the decimated readings; a new threshold starts
+        // over with a fresh baseline
+        bool transients_initialize(std::uint16_t threshold)
+        {
+            is_transient_enabled = false;
+            if (threshold == 0U) {
+                return true;
+            }
+
+            transient_config_t const config{.threshold = threshold,
+                                            .slope = threshold,
+                                            .release = static_cast<std::uint16_t>(threshold / 2U),
+                                            .hold_samples = TRANSIENT_HOLD_SAMPLES,
+                                            .max_samples = TRANSIENT_MAX_SAMPLES,
+                                            .baseline_shift = TRANSIENT_BASELINE_SHIFT,
+                                            .summary_samples = TRANSIENT_SUMMARY_SAMPLES};
+            for (auto& transient : transients) {
+                if (transient_initialize(&transient, &config) != TRANSIENT_ERR_OK) {
+                    return false;
+                }
+            }
+            is_transient_enabled = true;
+
+            return true;
+        }
+
+        // 0 stops, 1 takes the default states, more applies the thresholds added since the last
+        // call; the hysteresis grows with the threshold, an eighth of it plus two LSBs of noise
+        bool segmenter_start(std::uint16_t state_count)
+        {
+            std::size_t const count = segment_threshold_count;
+            segment_threshold_count = 0U;
+
+            is_segmenter_enabled = false;
+            if (state_count == 0U) {
+                return true;
+            }
+
+            segmenter_config_t config{
+                .state_count = state_count, .thresholds = {}, .hysteresis = {}, .dwell_samples = SEGMENTER_DWELL_SAMPLES};
+            if (state_count == 1U) {
+                config.state_count = SEGMENTER_DEFAULT_THRESHOLDS.size() + 1U;
+                std::copy(SEGMENTER_DEFAULT_THRESHOLDS.begin(), SEGMENTER_DEFAULT_THRESHOLDS.end(), config.thresholds);
+            } else if (count + 1U == state_count) {
+                std::copy_n(segment_thresholds.begin(), count, config.thresholds);
+            } else {
+                return false;
+            }
+            for (std::size_t i = 0U; i + 1U < config.state_count; ++i) {
+                if (config.thresholds[i] <= 0) {
+                    return false;
+                }
+                config.hysteresis[i] = static_cast<std::uint16_t>(config.thresholds[i] / 8 + 2);
+            }
+
+            if (segmenter_initialize(&segmenter, &config) != SEGMENTER_ERR_OK) {
+                return false;
+            }
+            is_segmenter_enabled = true;
+
+            return true;
+        }
+
+        // 0 continuous, 1 triggered; the device goes back to continuous conversions itself, the
+        // triggered mode writes its CONFIG with every batch
+        command_status_t acquisition_mode_apply(std::uint16_t value)
+        {
+            if (value > 1U) {
+                return COMMAND_STATUS_BAD_VALUE;
+            }
+
+            acquisition_mode_t const mode = value != 0U ? acquisition_mode_t::triggered : acquisition_mode_t::continuous;
+            if (mode == acquisition_mode_t::continuous && acquisition_mode == acquisition_mode_t::triggered) {
+                ina226_config_reg_t reg = ina226.config_reg;
+                reg.mode = INA226_OPERATING_MODE_SHUNT_BUS_CONTINUOUS;
+                if (ina226_set_config_reg(&ina226, &reg) != INA226_ERR_OK) {
+                    return COMMAND_STATUS_BUS_FAIL;
+                }
+                std::array<std::uint8_t, ACQUISITION_MAX_DEVICES> order{};
+                std::iota(order.begin(), order.begin() + acquisition.device_count, std::uint8_t{0U});
+                acquisition_pipeline.set_read_order(order.data(), acquisition.device_count);
+            }
+            acquisition_mode = mode;
+
+            return COMMAND_STATUS_OK;
+        }
+
+    } // namespace
+
+    void shunt_filters_initialize()
+    {
+        filter_fir_config_t fir_config{};
+        std::copy(SHUNT_FIR_TAPS.begin(), SHUNT_FIR_TAPS.end(), fir_config.coefficients);
+        fir_config.taps = SHUNT_FIR_TAPS.size();
+
+        filter_biquad_config_t notch_config{};
+        notch_config.sections[0] = SHUNT_NOTCH;
+        notch_config.section_count = 1U;
+
+        for (auto& filter : shunt_filters) {
+            filter.count = 0U;
+            filter_fir_initialize(&filter.fir, &fir_config);
+            filter_biquad_initialize(&filter.notch, &notch_config);
+        }
+    }
+
+    bool decimators_initialize(std::uint32_t ratio)
+    {
+        if (ratio == 0U || ratio > DECIMATOR_MAX_RATIO || (ratio & (ratio - 1U)) != 0U) {
+            return false;
+        }
+
+        decimator_config_t const config{.order = DECIMATOR_ORDER, .ratio = ratio};
+        for (auto& decimator : shunt_decimators) {
+            if (decimator_initialize(&decimator, &config) != DECIMATOR_ERR_OK) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    command_status_t command_app_op(void*, std::uint8_t op, std::uint16_t value, std::uint16_t*)
+    {
+        switch (op) {
+            case COMMAND_OP_TELEMETRY:
+                runtime_set_events(&runtime, telemetry_task, EVENT_TELEMETRY);
+                return COMMAND_STATUS_OK;
+            case COMMAND_OP_RESET_COUNTERS:
+                command_reset_counters();
+                return COMMAND_STATUS_OK;
+            case COMMAND_OP_SET_PROFILE:
+                if (value >= PROFILE_COUNT) {
+                    return COMMAND_STATUS_BAD_VALUE;
+                }
+                if (ina226_apply_profile(&ina226, &profiles[value]) != INA226_ERR_OK) {
+                    return COMMAND_STATUS_BUS_FAIL;
+                }
+                // the profile puts back the trigger limit, a held release limit follows next block
+                alert_limit_applied(&alert, profiles[value].alert_limit);
+                return COMMAND_STATUS_OK;
+            case COMMAND_OP_SET_DECIMATION:
+                return decimators_initialize(value) ? COMMAND_STATUS_OK : COMMAND_STATUS_BAD_VALUE;
+            case COMMAND_OP_SET_TRANSIENT:
+                return transients_initialize(value) ? COMMAND_STATUS_OK : COMMAND_STATUS_BAD_VALUE;
+            case COMMAND_OP_ADD_SEGMENT_THRESHOLD:
+                if (segment_threshold_count == segment_thresholds.size()) {
+                    return COMMAND_STATUS_BAD_VALUE;
+                }
+                segment_thresholds[segment_threshold_count++] = static_cast<std::int16_t>(value);
+                return COMMAND_STATUS_OK;
+            case COMMAND_OP_SET_SEGMENTER:
+                return segmenter_start(value) ? COMMAND_STATUS_OK : COMMAND_STATUS_BAD_VALUE;
+            case COMMAND_OP_DUMP_HISTOGRAM:
+                if (value & ~HISTOGRAM_RESET_FLAG) {
+                    return COMMAND_STATUS_BAD_VALUE;
+                }
+                return histogram_dump(value);
+            case COMMAND_OP_ARM_CAPTURE:
+                return capture_start(static_cast<std::int16_t>(value));
+            case COMMAND_OP_DISARM_CAPTURE:
+                capture_stream.is_active = false;
+                capture_disarm(&capture);
+                return COMMAND_STATUS_OK;
+            case COMMAND_OP_SET_ALERT_LIMIT_LOW:
+                alert_limit_bits = (alert_limit_bits & 0xFFFF0000UL) | value;
+                return COMMAND_STATUS_OK;
+            case COMMAND_OP_SET_ALERT_LIMIT_HIGH:
+                alert_limit_bits = (alert_limit_bits & 0x0000FFFFUL) | (static_cast<std::uint32_t>(value) << 16U);
+                return COMMAND_STATUS_OK;
+            case COMMAND_OP_SET_ALERT:
+                if ((value & 0xFFU) >= INA226_ALERT_COUNT) {
+                    return COMMAND_STATUS_BAD_VALUE;
+                }
+                return alert_apply({.function = static_cast<ina226_alert_function_t>(value & 0xFFU),
+                                    .limit = std::bit_cast<float32_t>(alert_limit_bits),
+                                    .is_latched = (value & ALERT_LATCH_FLAG) != 0U});
+            case COMMAND_OP_SET_ALERT_HYSTERESIS:
+                if (value > 1U) {
+                    return COMMAND_STATUS_BAD_VALUE;
+                }
+                return alert_hysteresis_apply(value != 0U, std::bit_cast<float32_t>(alert_limit_bits));
+            case COMMAND_OP_SET_ACQUISITION_MODE:
+                return acquisition_mode_apply(value);
+            case COMMAND_OP_SET_BANDWIDTH:
+                return adaptive_set_bandwidth(&adaptive, value) == ADAPTIVE_ERR_OK ? COMMAND_STATUS_OK
+                                                                                   : COMMAND_STATUS_BAD_VALUE;
+            default:
+                return COMMAND_STATUS_BAD_OP;
+        }
+    }
+
+} // namespace app
@@ -1,10 +1,1050 @@
+#include "dma.h"
+#include "gpio.h"
+#include "i2c.h"
 #include "main.h"
+#include "tim.h"
+#include "usart.h"
+
+#include "app.hpp"
+#include "arena.hpp"
+#include "deferred_logger.hpp"
+#include "executor.hpp"
+#include "i2c_transport.hpp"
+#include "ina226_device.hpp"
+#include "memory_sections.h"
+#include "pipeline.hpp"
+#include "resource.hpp"
+#include "task.hpp"
+
+extern "C" {
+#include "acquisition.h"
+#include "adaptive.h"
+#include "alert.h"
+#include "bus_scheduler.h"
+#include "capture.h"
+#include "command.h"
+#include "decimator.h"
+#include "filter.h"
+#include "histogram.h"
+#include "ina226.h"
+#include "runtime.h"
+#include "sampler.h"
+#include "segmenter.h"
+#include "transient.h"
+}
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+
+// the state records.cpp, telemetry.cpp and app_ops.cpp share is defined here, in app
+using namespace app;
+
+namespace {
+
+    struct ina226_bus_t {
+        I2C_HandleTypeDef* hi2c;
+        std::uint16_t address;
+    };
+
+    ina226_bus_t ina226_bus{&hi2c1, INA226_SLAVE_ADDRESS_A1_GND_A0_GND};
+    // bumped with every CONFIG change and carried by the sample blocks as their tag
+    std::uint32_t config_epoch{};
+    // the batch whose conversions are running, read by the block that follows once ready
+    acquisition_batch_t trigger_batch{};
+    bool is_trigger_pending{};
+
+    // written by DMA, the receive event callback publishes how far
+    MEMORY_SRAM2_BSS std::array<std::uint8_t, COMMAND_RX_BUFFER_SIZE> command_rx_buffer{};
+    MEMORY_SRAM2_BSS volatile std::uint16_t command_rx_head{};
+    std::uint16_t command_rx_tail{};
+    command_t command{};
+
+    std::uint8_t* log_tx_buffer{nullptr};
+    volatile bool log_tx_busy{false};
+
+    // callbacks the shared objects below are wired to
+    std::uint32_t dwt_get_cycles(void*);
+    void log_wake(void*);
+    void executor_wake(void*);
+    async::err i2c1_start_read(void* user, std::uint8_t address, std::uint8_t reg, std::uint8_t* data, std::size_t size);
+    async::err i2c1_start_write(void* user,
+                                std::uint8_t address,
+                                std::uint8_t reg,
+                                std::uint8_t const* data,
+                                std::size_t size);
+    void i2c1_critical_enter(void*);
+    void i2c1_critical_exit(void*);
+    bool pipeline_begin_block(void*, std::uint64_t* timestamp_us, std::uint32_t* tag, std::uint8_t* stale_mask);
+    void pipeline_block_ready(void*);
+    void pipeline_aggregate(void*, async::sample_block const& block);
+
+} // namespace
+
+namespace app {
+
+    ina226_t ina226{};
+    // completed once at startup with the calibration for the configured current range
+    std::array<ina226_profile_t, PROFILE_COUNT> profiles{};
+    adaptive_t adaptive{};
+    acquisition_t acquisition{};
+    acquisition_mode_t acquisition_mode{acquisition_mode_t::continuous};
+    trigger_stats_t trigger_stats{};
+    bus_scheduler_t bus_scheduler{};
+    std::size_t bus_channel{BUS_SCHEDULER_MAX_CHANNELS};
+    // state shared with the timer, I2C and UART interrupts lives in SRAM2, away from the
+    // processing buffers in SRAM1
+    MEMORY_SRAM2_BSS sampler_t sampler{};
+    MEMORY_SRAM2_BSS runtime_t runtime{};
+
+    std::size_t acquisition_task{};
+    std::size_t processing_task{};
+    std::size_t telemetry_task{};
+    std::size_t command_task{};
+    std::size_t log_task{};
+    std::size_t capture_task{};
+    std::size_t histogram_task{};
+
+    std::array<channel_stats_t, ACQUISITION_MAX_DEVICES> channel_stats{};
+    std::array<shunt_filter_t, ACQUISITION_MAX_DEVICES> shunt_filters{};
+    std::array<decimator_t, ACQUISITION_MAX_DEVICES> shunt_decimators{};
+    std::array<transient_t, ACQUISITION_MAX_DEVICES> transients{};
+    bool is_transient_enabled{};
+
+    histogram_t shunt_histogram{};
+    // what a dump sends, so inserts can go on while it drains
+    histogram_t histogram_snapshot{};
+    histogram_stream_t histogram_stream{};
+
+    segmenter_t segmenter{};
+    bool is_segmenter_enabled{};
+    // thresholds arrive one op each, SET_SEGMENTER then applies them
+    std::array<std::int16_t, SEGMENTER_MAX_STATES - 1U> segment_thresholds{};
+    std::size_t segment_threshold_count{};
+    std::uint32_t shunt_filter_max_cycles{};
+
+    capture_t capture{};
+    capture_stream_t capture_stream{};
+    std::uint32_t alerts{};
+
+    // the fast protection path: the pin interrupt dispatches straight to the registered handlers
+    MEMORY_SRAM2_BSS alert_t alert{};
+    ina226_alert_t alert_setting{};
+    // a limit arrives as the two halves of a float32 in two ops, SET_ALERT then applies it
+    std::uint32_t alert_limit_bits{};
+    bool is_alert_acknowledge_pending{};
+
+    // handler cycles from entry to exit, the share of worst-case latency that code placement
+    // decides; written by the handlers themselves, printed by telemetry and cleared by the reset counters command
+    MEMORY_SRAM2_BSS std::array<isr_profile_stats_t, ISR_PROFILE_COUNT> isr_profiles{};
+    std::uint32_t sampler_overruns{};
+
+    // everything goes out as format id plus raw arguments, tools/logger_decode.py turns the
+    // UART stream back into text using the ELF
+    MEMORY_SRAM2 constinit logger::deferred_logger event_log{{.user = nullptr, .get_timestamp = dwt_get_cycles, .wake = log_wake}};
+
+    constinit memory::static_arena<INIT_ARENA_SIZE> init_arena{"init"};
+    char const* volatile memory_failure_name{nullptr};
+    volatile std::uint32_t memory_failures{};
+
+    MEMORY_SRAM2 constinit async::executor executor{nullptr, executor_wake};
+    MEMORY_SRAM2 async::i2c_transport i2c1_bus{executor,
+                                               {.user = &hi2c1,
+                                                .start_read = i2c1_start_read,
+                                                .start_write = i2c1_start_write,
+                                                .critical_enter = i2c1_critical_enter,
+                                                .critical_exit = i2c1_critical_exit,
+                                                .get_cycles = dwt_get_cycles}};
+
+    MEMORY_SRAM2 async::pipeline acquisition_pipeline{i2c1_bus,
+                                                      {.user = nullptr,
+                                                       .begin_block = pipeline_begin_block,
+                                                       .block_ready = pipeline_block_ready,
+                                                       .aggregate = pipeline_aggregate,
+                                                       .get_cycles = dwt_get_cycles}};
+
+} // namespace app
+
+namespace {
+
+    MEMORY_SRAM2 async::event sample_tick{executor};
+    async::ina226_device ina226_async{i2c1_bus, INA226_SLAVE_ADDRESS_A1_GND_A0_GND};
+
+    std::uint32_t dwt_get_cycles(void*)
+    {
+        return DWT->CYCCNT;
+    }
+
+    void log_wake(void*)
+    {
+        runtime_set_events(&runtime, log_task, EVENT_LOG);
+    }
+
+    void memory_failure(void*, char const* name, std::size_t size, std::size_t)
+    {
+        memory_failure_name = name;
+        memory_failures = memory_failures + 1U;
+        LOGGER_WRITE(event_log, "memory %s failed size=%u", name, static_cast<std::uint32_t>(size));
+    }
+
+    void executor_wake(void*)
+    {
+        runtime_set_events(&runtime, acquisition_task, EVENT_ASYNC);
+    }
+
+    async::err i2c1_start_read(void* user,
+                               std::uint8_t address,
+                               std::uint8_t reg,
+                               std::uint8_t* data,
+                               std::size_t size)
+    {
+        return HAL_I2C_Mem_Read_IT(static_cast<I2C_HandleTypeDef*>(user),
+                                   static_cast<std::uint16_t>(address << 1U),
+                                   reg,
+                                   I2C_MEMADD_SIZE_8BIT,
+                                   data,
+                                   static_cast<std::uint16_t>(size)) == HAL_OK
+                   ? async::err::ok
+                   : async::err::fail;
+    }
+
+    async::err i2c1_start_write(void* user,
+                                std::uint8_t address,
+                                std::uint8_t reg,
+                                std::uint8_t const* data,
+                                std::size_t size)
+    {
+        return HAL_I2C_Mem_Write_IT(static_cast<I2C_HandleTypeDef*>(user),
+                                    static_cast<std::uint16_t>(address << 1U),
+                                    reg,
+                                    I2C_MEMADD_SIZE_8BIT,
+                                    const_cast<std::uint8_t*>(data),
+                                    static_cast<std::uint16_t>(size)) == HAL_OK
+                   ? async::err::ok
+                   : async::err::fail;
+    }
+
+    void i2c1_critical_enter(void*)
+    {
+        HAL_NVIC_DisableIRQ(I2C1_EV_IRQn);
+        HAL_NVIC_DisableIRQ(I2C1_ER_IRQn);
+    }
+
+    void i2c1_critical_exit(void*)
+    {
+        HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+        HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+    }
+
+    ina226_err_t ina226_bus_write(void* user,
+                                  std::uint8_t address,
+                                  std::uint8_t const* data,
+                                  std::size_t data_size)
+    {
+        auto const* bus = static_cast<ina226_bus_t const*>(user);
+
+        return HAL_I2C_Mem_Write(bus->hi2c,
+                                 static_cast<std::uint16_t>(bus->address << 1U),
+                                 address,
+                                 I2C_MEMADD_SIZE_8BIT,
+                                 const_cast<std::uint8_t*>(data),
+                                 static_cast<std::uint16_t>(data_size),
+                                 I2C_TIMEOUT_MS) == HAL_OK
+                   ? INA226_ERR_OK
+                   : INA226_ERR_FAIL;
+    }
+
+    ina226_err_t ina226_bus_read(void* user,
+                                 std::uint8_t address,
+                                 std::uint8_t* data,
+                                 std::size_t data_size)
+    {
+        auto const* bus = static_cast<ina226_bus_t const*>(user);
+
+        return HAL_I2C_Mem_Read(bus->hi2c,
+                                static_cast<std::uint16_t>(bus->address << 1U),
+                                address,
+                                I2C_MEMADD_SIZE_8BIT,
+                                data,
+                                static_cast<std::uint16_t>(data_size),
+                                I2C_TIMEOUT_MS) == HAL_OK
+                   ? INA226_ERR_OK
+                   : INA226_ERR_FAIL;
+    }
+
+    ina226_err_t ina226_timer_get_us(void* user, std::uint64_t* us)
+    {
+        return sampler_get_time_us(static_cast<sampler_t const*>(user), us) == SAMPLER_ERR_OK
+                   ? INA226_ERR_OK
+                   : INA226_ERR_FAIL;
+    }
+
+    ina226_err_t ina226_timer_delay_us(void* user, std::uint32_t us)
+    {
+        auto const* timebase = static_cast<sampler_t const*>(user);
+        std::uint64_t start_us{};
+        std::uint64_t now_us{};
+
+        if (sampler_get_time_us(timebase, &start_us) != SAMPLER_ERR_OK) {
+            return INA226_ERR_FAIL;
+        }
+        do {
+            sampler_get_time_us(timebase, &now_us);
+        } while (now_us - start_us < us);
+
+        return INA226_ERR_OK;
+    }
+
+    alert_err_t alert_timer_get_us(void* user, std::uint64_t* us)
+    {
+        return sampler_get_time_us(static_cast<sampler_t const*>(user), us) == SAMPLER_ERR_OK ? ALERT_ERR_OK
+                                                                                             : ALERT_ERR_FAIL;
+    }
+
+    // ALERT is open drain with APOL clear, so asserted is low
+    MEMORY_RAMFUNC bool alert_pin_is_asserted(void*)
+    {
+        return HAL_GPIO_ReadPin(GPIOB, GPIO_PIN_5) == GPIO_PIN_RESET;
+    }
+
+    MEMORY_RAMFUNC void alert_pin_mask(void*)
+    {
+        CLEAR_BIT(EXTI->IMR1, EXTI_IMR1_IM5);
+    }
+
+    void alert_pin_unmask(void*)
+    {
+        __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_5);
+        SET_BIT(EXTI->IMR1, EXTI_IMR1_IM5);
+    }
+
+    // interrupt context; everything that needs the bus happens in the task
+    MEMORY_RAMFUNC void alert_forward(void*, std::uint64_t)
+    {
+        runtime_set_events(&runtime, acquisition_task, EVENT_ALERT);
+    }
+
+    acquisition_err_t acquisition_timer_get_us(void* user, std::uint64_t* us)
+    {
+        return sampler_get_time_us(static_cast<sampler_t const*>(user), us) == SAMPLER_ERR_OK
+                   ? ACQUISITION_ERR_OK
+                   : ACQUISITION_ERR_FAIL;
+    }
+
+    // TIM6 runs from the 80 MHz APB1 clock; ticks stay at 1 us up to the 16-bit ARR limit and
+    // get coarser beyond it
+    sampler_err_t sampler_timer_start(void* user, std::uint32_t period_us)
+    {
+        auto* htim = static_cast<TIM_HandleTypeDef*>(user);
+        std::uint32_t const tick_us = (period_us + 0xFFFFU) / 0x10000U;
+
+        if (tick_us == 0U || tick_us > 0x10000U / 80U) {
+            return SAMPLER_ERR_FAIL;
+        }
+
+        __HAL_TIM_SET_PRESCALER(htim, 80U * tick_us - 1U);
+        __HAL_TIM_SET_AUTORELOAD(htim, period_us / tick_us - 1U);
+        __HAL_TIM_SET_COUNTER(htim, 0U);
+        // load the new prescaler now rather than at the first update
+        htim->Instance->EGR = TIM_EGR_UG;
+        __HAL_TIM_CLEAR_FLAG(htim, TIM_FLAG_UPDATE);
+
+        return HAL_TIM_Base_Start_IT(htim) == HAL_OK ? SAMPLER_ERR_OK : SAMPLER_ERR_FAIL;
+    }
+
+    sampler_err_t sampler_timer_stop(void* user)
+    {
+        return HAL_TIM_Base_Stop_IT(static_cast<TIM_HandleTypeDef*>(user)) == HAL_OK
+                   ? SAMPLER_ERR_OK
+                   : SAMPLER_ERR_FAIL;
+    }
+
+    sampler_err_t sampler_timer_get_count(void*, std::uint32_t* count)
+    {
+        *count = __HAL_TIM_GET_COUNTER(&htim2);
+
+        return SAMPLER_ERR_OK;
+    }
+
+    // the update flag stays set until the TIM2 handler runs, which neither the idle path with
+    // interrupts masked nor the ALERT handler at the same priority let happen
+    sampler_err_t sampler_timer_is_overflow_pending(void*, bool* is_pending)
+    {
+        *is_pending = __HAL_TIM_GET_FLAG(&htim2, TIM_FLAG_UPDATE) != RESET;
+
+        return SAMPLER_ERR_OK;
+    }
+
+    runtime_err_t runtime_get_time_us(void* user, std::uint64_t* time_us)
+    {
+        return sampler_get_time_us(static_cast<sampler_t const*>(user), time_us) == SAMPLER_ERR_OK
+                   ? RUNTIME_ERR_OK
+                   : RUNTIME_ERR_FAIL;
+    }
+
+    runtime_err_t runtime_get_cycles(void*, std::uint32_t* cycles)
+    {
+        *cycles = DWT->CYCCNT;
+
+        return RUNTIME_ERR_OK;
+    }
+
+    void runtime_critical_enter(void*)
+    {
+        __disable_irq();
+    }
+
+    void runtime_critical_exit(void*)
+    {
+        __enable_irq();
+    }
+
+    // called with interrupts masked; a pending interrupt still ends WFI and is taken once
+    // runtime_critical_exit unmasks it
+    void runtime_idle(void* user, std::uint64_t wakeup_us)
+    {
+        std::uint64_t now_us{};
+        sampler_get_time_us(static_cast<sampler_t const*>(user), &now_us);
+
+        if (wakeup_us <= now_us) {
+            return;
+        }
+
+        // TIM2 compare wakes the core for the next timer deadline, the overflow covers the rest
+        if (wakeup_us - now_us <= UINT32_MAX) {
+            __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_1, static_cast<std::uint32_t>(wakeup_us));
+            __HAL_TIM_CLEAR_FLAG(&htim2, TIM_FLAG_CC1);
+            __HAL_TIM_ENABLE_IT(&htim2, TIM_IT_CC1);
+        }
+
+        __WFI();
+    }
+
+    // a single CONFIG write, skipped when the step is what the device already runs
+    void adaptive_apply_change()
+    {
+        ina226_config_reg_t reg = ina226.config_reg;
+        if (adaptive_get_change(&adaptive, &reg) != ADAPTIVE_ERR_OK) {
+            return;
+        }
+
+        if (ina226_config_reg_to_word(&reg) == ina226_config_reg_to_word(&ina226.config_reg) ||
+            ina226_set_config_reg(&ina226, &reg) == INA226_ERR_OK) {
+            adaptive_change_applied(&adaptive);
+        }
+    }
+
+    // starts at the sample period, or the conversion time if that is longer, and halves the
+    // rate until the bus admits the four reads per block; restarts the release times
+    void bus_schedule_device(std::uint64_t now_us)
+    {
+        if (bus_channel < BUS_SCHEDULER_MAX_CHANNELS) {
+            bus_scheduler_remove_channel(&bus_scheduler, bus_channel);
+            bus_channel = BUS_SCHEDULER_MAX_CHANNELS;
+        }
+
+        bus_scheduler_channel_config_t config{.ina226 = &ina226,
+                                              .rate_hz = 1000000U / std::max(SAMPLE_PERIOD_US, ina226.conversion_time_us),
+                                              .reads_per_sample = PIPELINE_READS_PER_SAMPLE,
+                                              .avg = static_cast<ina226_avg_t>(ina226.config_reg.avg),
+                                              .vbus_ct = static_cast<ina226_vbus_ct_t>(ina226.config_reg.vbus_ct),
+                                              .vsh_ct = static_cast<ina226_vsh_ct_t>(ina226.config_reg.vsh_ct),
+                                              .mode = static_cast<ina226_mode_t>(ina226.config_reg.mode)};
+        while (config.rate_hz > 0U &&
+               bus_scheduler_add_channel(&bus_scheduler, &config, &bus_channel) != BUS_SCHEDULER_ERR_OK) {
+            config.rate_hz /= 2U;
+        }
+
+        if (config.rate_hz == 0U) {
+            LOGGER_WRITE(event_log, "bus scheduler rejected the device");
+            return;
+        }
+
+        bus_scheduler_start(&bus_scheduler, now_us);
+        LOGGER_WRITE(event_log,
+                     "bus scheduler rate=%luHz util=%luppm",
+                     config.rate_hz,
+                     bus_scheduler.utilization_ppm);
+    }
+
+    void bus_complete_released(std::uint64_t now_us)
+    {
+        std::size_t channel{};
+        while (bus_scheduler_get_next_channel(&bus_scheduler, now_us, &channel) == BUS_SCHEDULER_ERR_OK) {
+            bus_scheduler_complete_channel(&bus_scheduler, channel, now_us);
+        }
+    }
+
+    // a released slot triggers all devices, the block goes out on the first tick after the last
+    // conversion is ready, read in ready-time order and stamped with the first CONFIG write
+    bool pipeline_begin_triggered_block(std::uint64_t now_us,
+                                        std::uint64_t* timestamp_us,
+                                        std::uint32_t* tag,
+                                        std::uint8_t* stale_mask)
+    {
+        if (!is_trigger_pending) {
+            for (std::size_t i = 0U; i < acquisition.device_count; ++i) {
+                ina226_prepare_trigger(acquisition.devices[i].ina226, INA226_OPERATING_MODE_SHUNT_BUS_TRIGGERED);
+            }
+            if (acquisition_trigger_start(&acquisition, &trigger_batch) != ACQUISITION_ERR_OK ||
+                acquisition_pipeline.set_read_order(trigger_batch.order, acquisition.device_count) != async::err::ok) {
+                ++trigger_stats.errors;
+                bus_complete_released(now_us);
+                return false;
+            }
+
+            is_trigger_pending = true;
+            ++trigger_stats.batches;
+            trigger_stats.skew_sum_us += trigger_batch.skew_us;
+            trigger_stats.max_skew_us = std::max(trigger_stats.max_skew_us, trigger_batch.skew_us);
+        }
+
+        if (now_us < trigger_batch.ready_us) {
+            return false;
+        }
+
+        is_trigger_pending = false;
+        acquisition_trigger_collected(&acquisition, &trigger_batch);
+        bus_complete_released(now_us);
+
+        *timestamp_us = trigger_batch.timestamp_us;
+        *tag = config_epoch;
+        *stale_mask = 0U;
+        return true;
+    }
+
+    // one block per released scheduler slot, skipped while the device is still on the same
+    // conversion
+    bool pipeline_begin_block(void*, std::uint64_t* timestamp_us, std::uint32_t* tag, std::uint8_t* stale_mask)
+    {
+        // the previous block's transfers are done and the next have not started, so a held
+        // request or controller step gets the bus to itself; a CONFIG write restarts the
+        // ready-time tracking below
+        std::uint16_t const config_before = ina226_config_reg_to_word(&ina226.config_reg);
+        acquisition_mode_t const mode_before = acquisition_mode;
+        command_apply_pending(&command);
+        adaptive_apply_change();
+
+        // a latched ALERT holds the pin, and with it the edge interrupt, until this read
+        if (is_alert_acknowledge_pending) {
+            is_alert_acknowledge_pending = false;
+            ina226_acknowledge_alert(&ina226, nullptr);
+        }
+
+        // with hysteresis the limit moves between trigger and release as the pin changes
+        alert_poll(&alert, sampler.tick_us);
+        if (std::uint16_t limit{}; alert_get_limit_change(&alert, &limit) == ALERT_ERR_OK &&
+                                   ina226_update_alert_limit(&ina226, limit) == INA226_ERR_OK) {
+            alert_limit_applied(&alert, limit);
+        }
+
+        std::uint16_t const config_after = ina226_config_reg_to_word(&ina226.config_reg);
+        if (config_after != config_before || acquisition_mode != mode_before) {
+            ++config_epoch;
+            LOGGER_WRITE(event_log,
+                         "config epoch=%lu word=0x%04x conversion=%luus triggered=%u",
+                         config_epoch,
+                         static_cast<std::uint32_t>(config_after),
+                         ina226.conversion_time_us,
+                         static_cast<std::uint32_t>(acquisition_mode == acquisition_mode_t::triggered));
+            bus_schedule_device(sampler.tick_us);
+            // a running batch may have been cut short by the write, trigger again
+            is_trigger_pending = false;
+        }
+
+        std::uint32_t ticks{};
+        if (sampler_take_ticks(&sampler, &ticks) & SAMPLER_ERR_OVERRUN) {
+            ++sampler_overruns;
+        }
+        if (ticks == 0U) {
+            return false;
+        }
+
+        // the pipeline reads every device per block, so any released channel starts one
+        std::uint64_t const now_us = sampler.tick_us;
+        std::size_t channel{};
+        if (bus_scheduler_get_next_channel(&bus_scheduler, now_us, &channel) != BUS_SCHEDULER_ERR_OK) {
+            return false;
+        }
+
+        if (acquisition_mode == acquisition_mode_t::triggered) {
+            return pipeline_begin_triggered_block(now_us, timestamp_us, tag, stale_mask);
+        }
+
+        // one new conversion is enough for a block; devices still on their previous one are
+        // left out of it, the pipeline registers them in the same order as the acquisition
+        std::uint8_t stale{};
+        for (std::size_t i = 0U; i < acquisition.device_count; ++i) {
+            bool is_fresh{};
+            acquisition_err_t const err = acquisition_check_fresh(&acquisition, i, &is_fresh);
+            if (err == ACQUISITION_ERR_STALE || (err == ACQUISITION_ERR_OK && !is_fresh)) {
+                stale = static_cast<std::uint8_t>(stale | (1U << i));
+            }
+        }
+        if (stale == (1U << acquisition.device_count) - 1U) {
+            return false;
+        }
+
+        bus_complete_released(now_us);
+
+        *timestamp_us = now_us;
+        *tag = config_epoch;
+        *stale_mask = stale;
+        return true;
+    }
+
+    void pipeline_block_ready(void*)
+    {
+        runtime_set_events(&runtime, processing_task, EVENT_DATA);
+    }
+
+    void pipeline_aggregate(void*, async::sample_block const& block)
+    {
+        static std::uint32_t last_tag{};
+
+        if (block.tag != last_tag) {
+            last_tag = block.tag;
+            LOGGER_WRITE(event_log,
+                         "config epoch=%lu starts at seq=%lu t=%lluus",
+                         block.tag,
+                         block.sequence,
+                         block.timestamp_us);
+        }
+
+        // blocks still in flight across a change were converted with the old setting
+        if (block.tag == config_epoch && (block.valid_mask & 1U)) {
+            adaptive_update(&adaptive, block.measurements[0].current);
+        }
+
+        for (std::size_t i = 0U; i < block.device_count; ++i) {
+            auto& stats = channel_stats[i];
+
+            // already counted as suppressed by the acquisition
+            if (block.stale_mask & (1U << i)) {
+                continue;
+            }
+            if (!(block.valid_mask & (1U << i))) {
+                ++stats.errors;
+                continue;
+            }
+
+            auto const& measurement = block.measurements[i];
+
+            if (i == CAPTURE_CHANNEL) {
+                capture_push(&capture, measurement.shunt_raw, block.timestamp_us);
+                if (capture_is_frozen(&capture) && !capture_stream.is_active) {
+                    capture_stream = {.is_active = true, .is_header_sent = false, .offset = 0U};
+                    runtime_set_events(&runtime, capture_task, EVENT_CAPTURE);
+                }
+            }
+
+            if (i == HISTOGRAM_CHANNEL) {
+                histogram_insert(&shunt_histogram, measurement.shunt_raw, block.timestamp_us);
+            }
+
+            if (i == SEGMENTER_CHANNEL && is_segmenter_enabled) {
+                segmenter_push(&segmenter, measurement.shunt_raw, measurement.power, block.timestamp_us);
+                segments_send();
+            }
+
+            if (is_transient_enabled) {
+                transient_push(&transients[i], measurement.shunt_raw, block.timestamp_us);
+                transient_send(i);
+            }
+
+            auto& filter = shunt_filters[i];
+            filter.block[filter.count++] = measurement.shunt_raw;
+            if (filter.count == filter.block.size()) {
+                filter.count = 0U;
+
+                std::uint32_t const start = DWT->CYCCNT;
+                filter_fir_process(&filter.fir, filter.block.data(), filter.block.data(), filter.block.size());
+                filter_biquad_process(&filter.notch, filter.block.data(), filter.block.data(), filter.block.size());
+
+                std::array<std::int32_t, SHUNT_FILTER_BLOCK> decimated{};
+                std::size_t decimated_count{};
+                decimator_process(&shunt_decimators[i],
+                                  filter.block.data(),
+                                  filter.block.size(),
+                                  decimated.data(),
+                                  decimated.size(),
+                                  &decimated_count);
+                std::array<float32_t, SHUNT_FILTER_BLOCK> shunt_voltages{};
+                ina226_scale_block(filter.block.data(), shunt_voltages.data(), filter.block.size(), INA226_SHUNT_VOLTAGE_SCALE);
+                std::uint32_t const cycles = DWT->CYCCNT - start;
+                if (cycles > shunt_filter_max_cycles) {
+                    shunt_filter_max_cycles = cycles;
+                }
+
+                auto const [min, max] = std::minmax_element(shunt_voltages.begin(), shunt_voltages.end());
+                if (stats.filtered_blocks == 0U || *min < stats.filtered_shunt_min) {
+                    stats.filtered_shunt_min = *min;
+                }
+                if (stats.filtered_blocks == 0U || *max > stats.filtered_shunt_max) {
+                    stats.filtered_shunt_max = *max;
+                }
+                ++stats.filtered_blocks;
+
+                // integer all the way: the output is in 1 / (gain >> shift) input LSBs
+                auto const& decimator = shunt_decimators[i];
+                std::int64_t const divisor = static_cast<std::int64_t>(decimator.gain >> decimator.shift);
+                for (std::size_t k = 0U; k < decimated_count && !is_transient_enabled; ++k) {
+                    LOGGER_WRITE(event_log,
+                                 "shunt ch%u %lldnV over %lu results",
+                                 static_cast<std::uint32_t>(i),
+                                 static_cast<std::int64_t>(decimated[k]) * SHUNT_LSB_NV / divisor,
+                                 decimator.config.ratio);
+                }
+            }
+
+            stats.bus_voltage_sum += measurement.bus_voltage;
+            stats.current_sum += measurement.current;
+            stats.power_sum += measurement.power;
+
+            if (stats.count == 0U || measurement.current < stats.current_min) {
+                stats.current_min = measurement.current;
+            }
+            if (stats.count == 0U || measurement.current > stats.current_max) {
+                stats.current_max = measurement.current;
+            }
+            ++stats.count;
+        }
+    }
+
+    // the comparison time is reconstructed from the conversion timing, so this covers the
+    // pin, EXTI and dispatch path at the resolution of the conversion tracking
+    void alert_measure_latency()
+    {
+        std::uint64_t dispatch_us{};
+        std::uint64_t compare_us{};
+        if (alert_get_last_dispatch(&alert, &dispatch_us, nullptr) == ALERT_ERR_OK &&
+            ina226_get_alert_compare_time(&ina226, alert_setting.function, dispatch_us, &compare_us) == INA226_ERR_OK) {
+            alert_record_latency(&alert, compare_us, dispatch_us);
+        }
+    }
+
+    runtime_err_t acquisition_task_handler(void*, std::uint32_t events)
+    {
+        if (events & EVENT_ALERT) {
+            ++alerts;
+            capture_trigger(&capture, CAPTURE_SOURCE_ALERT);
+            alert_measure_latency();
+            is_alert_acknowledge_pending = alert_setting.is_latched;
+        }
+
+        executor.run();
+
+        return RUNTIME_ERR_OK;
+    }
+
+    runtime_err_t processing_task_handler(void*, std::uint32_t)
+    {
+        acquisition_pipeline.aggregate();
+
+        return RUNTIME_ERR_OK;
+    }
+
+    // drains one UART buffer at a time; the transmit-complete interrupt asks for the next one
+    runtime_err_t log_task_handler(void*, std::uint32_t)
+    {
+        if (log_tx_busy || event_log.is_empty()) {
+            return RUNTIME_ERR_OK;
+        }
+
+        std::size_t const size = event_log.drain(log_tx_buffer, LOG_TX_BUFFER_SIZE);
+        if (size == 0U) {
+            return RUNTIME_ERR_OK;
+        }
+
+        if (capture_stream.is_active) {
+            runtime_set_events(&runtime, capture_task, EVENT_CAPTURE);
+        }
+        if (histogram_stream.is_active) {
+            runtime_set_events(&runtime, histogram_task, EVENT_HISTOGRAM);
+        }
+
+        log_tx_busy = true;
+        if (HAL_UART_Transmit_IT(&huart2, log_tx_buffer, static_cast<std::uint16_t>(size)) != HAL_OK) {
+            log_tx_busy = false;
+            return RUNTIME_ERR_FAIL;
+        }
+
+        return RUNTIME_ERR_OK;
+    }
+
+    void command_start_receive()
+    {
+        command_rx_head = 0U;
+        command_rx_tail = 0U;
+
+        if (HAL_UARTEx_ReceiveToIdle_DMA(&huart2, command_rx_buffer.data(), COMMAND_RX_BUFFER_SIZE) != HAL_OK) {
+            Error_Handler();
+        }
+    }
+
+    // responses share the UART with the log, as raw records the host client picks out
+    void command_respond(void*, std::uint32_t const* words, std::size_t count)
+    {
+        event_log.write_words(COMMAND_RESPONSE_ID, words, count);
+    }
+
+    runtime_err_t command_task_handler(void*, std::uint32_t events)
+    {
+        if (events & EVENT_COMMAND_RX_STOPPED) {
+            // a frame cut short by the error is answered as malformed rather than glued to
+            // whatever arrives next
+            std::uint8_t const delimiter{0U};
+            command_receive(&command, &delimiter, 1U);
+            command_start_receive();
+            return RUNTIME_ERR_OK;
+        }
+
+        std::uint16_t const head = command_rx_head;
+        if (head == command_rx_tail) {
+            return RUNTIME_ERR_OK;
+        }
+
+        if (head < command_rx_tail) {
+            command_receive(&command,
+                            &command_rx_buffer[command_rx_tail],
+                            static_cast<std::size_t>(COMMAND_RX_BUFFER_SIZE - command_rx_tail));
+            command_rx_tail = 0U;
+        }
+        command_receive(&command, &command_rx_buffer[command_rx_tail], static_cast<std::size_t>(head - command_rx_tail));
+        command_rx_tail = head;
+
+        return RUNTIME_ERR_OK;
+    }
+
+    void dwt_enable() noexcept
+    {
+        CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0U;
+        DWT->CTRL = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+} // namespace
+
+extern "C" void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
+{
+    if (htim->Instance == TIM2) {
+        sampler_timer_overflow_callback(&sampler);
+    } else if (htim->Instance == TIM6) {
+        sampler_period_elapsed_callback(&sampler);
+        sample_tick.set();
+    }
+}
+
+extern "C" MEMORY_RAMFUNC void isr_profile_record(isr_profile_t isr, std::uint32_t cycles)
+{
+    auto& profile = isr_profiles[isr];
+
+    profile.count = profile.count + 1U;
+    profile.total_cycles = profile.total_cycles + cycles;
+    if (cycles > profile.max_cycles) {
+        profile.max_cycles = cycles;
+    }
+}
+
+extern "C" MEMORY_RAMFUNC void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (hi2c->Instance == I2C1) {
+        i2c1_bus.complete(true);
+    }
+}
+
+extern "C" MEMORY_RAMFUNC void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (hi2c->Instance == I2C1) {
+        i2c1_bus.complete(true);
+    }
+}
+
+extern "C" MEMORY_RAMFUNC void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c)
+{
+    if (hi2c->Instance == I2C1) {
+        LOGGER_WRITE(event_log, "i2c1 error code=0x%lx", hi2c->ErrorCode);
+        i2c1_bus.complete(false);
+    }
+}
+
+extern "C" MEMORY_RAMFUNC void HAL_GPIO_EXTI_Callback(std::uint16_t pin)
+{
+    if (pin == GPIO_PIN_5) {
+        alert_dispatch(&alert);
+    }
+}
+
+// called on idle line, half and full buffer; size is the DMA position within the buffer
+extern "C" void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, std::uint16_t size)
+{
+    if (huart->Instance == USART2) {
+        command_rx_head = size == COMMAND_RX_BUFFER_SIZE ? 0U : size;
+        runtime_set_events(&runtime, command_task, EVENT_COMMAND);
+    }
+}
+
+// overrun and DMA errors stop the reception, the command task restarts it
+extern "C" void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart)
+{
+    if (huart->Instance == USART2 && huart->RxState == HAL_UART_STATE_READY) {
+        runtime_set_events(&runtime, command_task, EVENT_COMMAND_RX_STOPPED);
+    }
+}
+
+extern "C" void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart)
+{
+    if (huart->Instance == USART2) {
+        log_tx_busy = false;
+        runtime_set_events(&runtime, log_task, EVENT_LOG);
+    }
+}
 
 int main()
 {
     HAL_Init();
     SystemClock_Config();
 
-    while (1) {
+    MX_GPIO_Init();
+    MX_DMA_Init();
+    MX_USART2_UART_Init();
+    MX_I2C1_Init();
+    MX_TIM2_Init();
+    MX_TIM6_Init();
+
+    dwt_enable();
+
+    // everything is statically allocated; anything that still asks for memory at runtime is
+    // reported instead of quietly growing the heap
+    memory::set_failure_hook(memory_failure, nullptr);
+    std::pmr::set_default_resource(memory::null_resource());
+
+    log_tx_buffer = static_cast<std::uint8_t*>(init_arena.allocate(LOG_TX_BUFFER_SIZE, alignof(std::uint32_t)));
+
+    if (HAL_TIM_Base_Start_IT(&htim2) != HAL_OK) {
+        Error_Handler();
+    }
+
+    runtime_interface_t const runtime_interface{.user = &sampler,
+                                                .get_time_us = runtime_get_time_us,
+                                                .get_cycles = runtime_get_cycles,
+                                                .critical_enter = runtime_critical_enter,
+                                                .critical_exit = runtime_critical_exit,
+                                                .idle = runtime_idle};
+    runtime_initialize(&runtime, &runtime_interface);
+
+    // registration order is the dispatch order within one pass
+    runtime_add_task(&runtime, acquisition_task_handler, nullptr, &acquisition_task);
+    runtime_add_task(&runtime, processing_task_handler, nullptr, &processing_task);
+    runtime_add_task(&runtime, command_task_handler, nullptr, &command_task);
+    runtime_add_task(&runtime, telemetry_task_handler, nullptr, &telemetry_task);
+    runtime_add_task(&runtime, log_task_handler, nullptr, &log_task);
+    runtime_add_task(&runtime, capture_task_handler, nullptr, &capture_task);
+    runtime_add_task(&runtime, histogram_task_handler, nullptr, &histogram_task);
+
+    // the sampler owns the 64-bit timebase the other modules timestamp against
+    acquisition_config_t const acquisition_config{.stale_policy = ACQUISITION_STALE_POLICY_DROP};
+    acquisition_interface_t const acquisition_interface{.timer_user = &sampler,
+                                                        .timer_get_us = acquisition_timer_get_us};
+    acquisition_initialize(&acquisition, &acquisition_config, &acquisition_interface);
+
+    sampler_config_t const sampler_config{.period_us = SAMPLE_PERIOD_US};
+    sampler_interface_t const sampler_interface{.timer_user = &htim6,
+                                                .timer_start = sampler_timer_start,
+                                                .timer_stop = sampler_timer_stop,
+                                                .timer_get_count = sampler_timer_get_count,
+                                                .timer_is_overflow_pending = sampler_timer_is_overflow_pending};
+    sampler_initialize(&sampler, &sampler_config, &sampler_interface);
+
+    alert_config_t const alert_config{.chatter_us = ALERT_CHATTER_US,
+                                      .rate_window_us = ALERT_RATE_WINDOW_US,
+                                      .rate_max_edges = ALERT_RATE_MAX_EDGES};
+    alert_interface_t const alert_interface{.timer_user = &sampler,
+                                            .timer_get_us = alert_timer_get_us,
+                                            .pin_user = nullptr,
+                                            .pin_is_asserted = alert_pin_is_asserted,
+                                            .pin_mask = alert_pin_mask,
+                                            .pin_unmask = alert_pin_unmask};
+    alert_initialize(&alert, &alert_config, &alert_interface);
+    alert_register_handler(&alert, alert_forward, nullptr, nullptr);
+
+    float32_t const current_scale = ina226_current_range_to_scale(CURRENT_RANGE_A);
+    ina226_config_t const ina226_config{
+        .current_scale = current_scale,
+        .calibration = ina226_scale_and_shunt_resistance_to_calibration(current_scale, SHUNT_RESISTANCE_OHM)};
+    ina226_interface_t const ina226_interface{.bus_user = &ina226_bus,
+                                              .bus_init = nullptr,
+                                              .bus_deinit = nullptr,
+                                              .bus_write = ina226_bus_write,
+                                              .bus_read = ina226_bus_read,
+                                              .timer_user = &sampler,
+                                              .timer_get_us = ina226_timer_get_us,
+                                              .timer_delay_us = ina226_timer_delay_us,
+                                              .alert_user = nullptr,
+                                              .alert_wait = nullptr};
+    ina226_initialize(&ina226, &ina226_config, &ina226_interface);
+
+    for (std::size_t i = 0U; i < PROFILE_COUNT; ++i) {
+        profiles[i] = {.config = PROFILE_CONFIG_WORDS[i],
+                       .calibration = static_cast<std::uint16_t>(ina226_config.calibration),
+                       .mask_enable = 0U,
+                       .alert_limit = 0U};
+    }
+    // the shadow starts out unknown, so this writes every register once
+    if (ina226_apply_profile(&ina226, &profiles[PROFILE_DEFAULT]) != INA226_ERR_OK) {
+        LOGGER_WRITE(event_log, "ina226 profile apply failed");
+    }
+
+    // starts on the ladder rung matching the default profile and moves from there
+    adaptive_config_t const adaptive_config{.window = ADAPTIVE_WINDOW,
+                                            .hold_windows = 2U,
+                                            .noise_variance = ADAPTIVE_NOISE_LSB * ADAPTIVE_NOISE_LSB * current_scale * current_scale,
+                                            .faster_ratio = 24.0F,
+                                            .slower_ratio = 4.0F,
+                                            .bandwidth_hz = ADAPTIVE_BANDWIDTH_HZ,
+                                            .initial_step = 2U};
+    adaptive_initialize(&adaptive, &adaptive_config);
+
+    shunt_filters_initialize();
+    // idle until armed by command
+    capture_config_t const capture_config{.pre_samples = CAPTURE_PRE_SAMPLES,
+                                          .post_samples = CAPTURE_POST_SAMPLES,
+                                          .is_threshold_enabled = false,
+                                          .threshold = 0};
+    capture_initialize(&capture, &capture_config);
+    decimators_initialize(DECIMATOR_RATIO);
+    histogram_initialize(&shunt_histogram);
+
+    std::size_t device{};
+    acquisition_register_device(&acquisition, &ina226, &device);
+
+    std::size_t telemetry_timer{};
+    runtime_add_timer(&runtime, telemetry_task, EVENT_TELEMETRY, TELEMETRY_PERIOD_US, TELEMETRY_PERIOD_US, &telemetry_timer);
+
+    acquisition_pipeline.add_device(ina226_async, ina226);
+    bus_scheduler_config_t const bus_scheduler_config{.policy = BUS_SCHEDULER_POLICY_RATE_MONOTONIC,
+                                                      .bus_frequency_hz = I2C1_FREQUENCY_HZ,
+                                                      .transaction_overhead_ns = I2C1_TRANSACTION_OVERHEAD_NS,
+                                                      .utilization_limit_ppm = 0U};
+    bus_scheduler_initialize(&bus_scheduler, &bus_scheduler_config);
+    bus_schedule_device(0U);
+    if (executor.spawn(acquisition_pipeline.run(sample_tick)) != async::err::ok) {
+        Error_Handler();
     }
+
+    command_interface_t const command_interface{.user = nullptr,
+                                                .respond = command_respond,
+                                                .app_op = command_app_op};
+    command_initialize(&command, &command_interface);
+    std::size_t command_device{};
+    command_register_device(&command, &ina226, &command_device);
+
+    command_start_receive();
+
+    if (sampler_start(&sampler) != SAMPLER_ERR_OK) {
+        Error_Handler();
+    }
+
+    runtime_run(&runtime);
 }
@@ -0,0 +1,186 @@
+#include "app.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+
+namespace app {
+
+    // a record the log has no room for stays queued for the next block
+    void transient_send(std::size_t channel)
+    {
+        // LSB us to nC
+        constexpr float32_t NC_PER_AREA = INA226_SHUNT_VOLTAGE_SCALE / SHUNT_RESISTANCE_OHM * 1000.0F;
+
+        transient_record_t record{};
+        while (transient_peek(&transients[channel], &record) == TRANSIENT_ERR_OK) {
+            std::uint32_t const header = static_cast<std::uint32_t>(channel) << 16U;
+
+            if (record.kind == TRANSIENT_RECORD_EVENT) {
+                auto const& event = record.event;
+                std::array<std::uint32_t, 10U> const words{
+                    (TRANSIENT_RECORD_EVENT << 24U) | header,
+                    static_cast<std::uint32_t>(event.start_us),
+                    static_cast<std::uint32_t>(event.start_us >> 32U),
+                    event.duration_us,
+                    event.samples,
+                    static_cast<std::uint16_t>(event.peak) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(event.baseline)) << 16U),
+                    event.peak_offset,
+                    static_cast<std::uint32_t>(static_cast<std::uint64_t>(event.area)),
+                    static_cast<std::uint32_t>(static_cast<std::uint64_t>(event.area) >> 32U),
+                    std::bit_cast<std::uint32_t>(static_cast<float32_t>(event.area) * NC_PER_AREA)};
+                if (!event_log.write_words(TRANSIENT_RECORD_ID, words.data(), words.size())) {
+                    return;
+                }
+            } else {
+                auto const& summary = record.summary;
+                float32_t const mean = summary.quiet_samples
+                                           ? static_cast<float32_t>(summary.sum) / static_cast<float32_t>(summary.quiet_samples)
+                                           : static_cast<float32_t>(summary.baseline);
+                std::array<std::uint32_t, 9U> const words{
+                    (TRANSIENT_RECORD_SUMMARY << 24U) | header,
+                    static_cast<std::uint32_t>(summary.end_us),
+                    static_cast<std::uint32_t>(summary.end_us >> 32U),
+                    summary.samples,
+                    summary.quiet_samples,
+                    static_cast<std::uint16_t>(summary.min) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(summary.max)) << 16U),
+                    static_cast<std::uint16_t>(summary.baseline),
+                    std::bit_cast<std::uint32_t>(mean),
+                    summary.events};
+                if (!event_log.write_words(TRANSIENT_RECORD_ID, words.data(), words.size())) {
+                    return;
+                }
+            }
+
+            transient_pop(&transients[channel]);
+        }
+    }
+
+    void segments_send()
+    {
+        constexpr float32_t COULOMB_PER_SHUNT_US = INA226_SHUNT_VOLTAGE_SCALE / SHUNT_RESISTANCE_OHM * 1e-6F;
+
+        segmenter_segment_t segment{};
+        while (segmenter_peek(&segmenter, &segment) == SEGMENTER_ERR_OK) {
+            std::uint32_t const sequence = segment.sequence & 0xFFFFU;
+            std::array<std::uint32_t, 8U> const words{
+                segment.state | (sequence << 16U),
+                static_cast<std::uint32_t>(segment.start_us),
+                static_cast<std::uint32_t>(segment.start_us >> 32U),
+                segment.duration_us,
+                segment.samples,
+                static_cast<std::uint16_t>(segment.shunt_min) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(segment.shunt_max)) << 16U),
+                std::bit_cast<std::uint32_t>(static_cast<float32_t>(segment.shunt_us) * COULOMB_PER_SHUNT_US),
+                std::bit_cast<std::uint32_t>(segment.energy)};
+            if (!event_log.write_words(SEGMENT_RECORD_ID, words.data(), words.size())) {
+                return;
+            }
+
+            segmenter_pop(&segmenter);
+        }
+    }
+
+    // lowest priority: tops up the log only once everything else is drained, and the log task
+    // wakes it again per UART buffer, so a window never crowds out other records
+    runtime_err_t capture_task_handler(void*, std::uint32_t)
+    {
+        if (!capture_stream.is_active || !event_log.is_empty()) {
+            return RUNTIME_ERR_OK;
+        }
+
+        std::uint32_t const sequence = capture.sequence & 0xFFFFU;
+
+        if (!capture_stream.is_header_sent) {
+            std::array<std::uint32_t, 4U> const words{
+                (CAPTURE_RECORD_HEADER << 24U) | (static_cast<std::uint32_t>(capture.source) << 16U) | sequence,
+                static_cast<std::uint32_t>(capture.pre_count) | (static_cast<std::uint32_t>(capture_get_count(&capture)) << 16U),
+                static_cast<std::uint32_t>(capture.trigger_us),
+                static_cast<std::uint32_t>(capture.trigger_us >> 32U)};
+            if (!event_log.write_words(CAPTURE_RECORD_ID, words.data(), words.size())) {
+                return RUNTIME_ERR_OK;
+            }
+            capture_stream.is_header_sent = true;
+        }
+
+        for (std::size_t record = 0U; record < CAPTURE_RECORDS_PER_RUN; ++record) {
+            std::array<std::int16_t, CAPTURE_SAMPLES_PER_RECORD> samples{};
+            std::size_t const count = capture_read(&capture, capture_stream.offset, samples.data(), samples.size());
+            if (count == 0U) {
+                // the window is out, look for the next one
+                capture_stream.is_active = false;
+                capture_arm(&capture);
+                return RUNTIME_ERR_OK;
+            }
+
+            std::array<std::uint32_t, 2U + CAPTURE_SAMPLES_PER_RECORD / 2U> words{};
+            words[0] = (CAPTURE_RECORD_DATA << 24U) | sequence;
+            words[1] = static_cast<std::uint32_t>(capture_stream.offset) | (static_cast<std::uint32_t>(count) << 16U);
+            for (std::size_t k = 0U; k < count; ++k) {
+                words[2U + k / 2U] |= static_cast<std::uint32_t>(static_cast<std::uint16_t>(samples[k])) << (16U * (k % 2U));
+            }
+            if (!event_log.write_words(CAPTURE_RECORD_ID, words.data(), 2U + (count + 1U) / 2U)) {
+                return RUNTIME_ERR_OK;
+            }
+            capture_stream.offset += count;
+        }
+
+        return RUNTIME_ERR_OK;
+    }
+
+    // like the capture task: only into an empty log, woken again per UART buffer
+    runtime_err_t histogram_task_handler(void*, std::uint32_t)
+    {
+        if (!histogram_stream.is_active || !event_log.is_empty()) {
+            return RUNTIME_ERR_OK;
+        }
+
+        auto const& snapshot = histogram_snapshot;
+        std::uint32_t const sequence = histogram_stream.sequence & 0xFFFFU;
+
+        if (!histogram_stream.is_header_sent) {
+            auto const buckets = static_cast<std::uint32_t>(
+                std::count_if(std::begin(snapshot.counts), std::end(snapshot.counts), [](std::uint32_t count) { return count > 0U; }));
+            std::array<std::uint32_t, 11U> const words{
+                (HISTOGRAM_RECORD_HEADER << 24U) | (HISTOGRAM_SUB_BUCKET_BITS << 16U) | sequence,
+                static_cast<std::uint32_t>(snapshot.total),
+                static_cast<std::uint32_t>(snapshot.total >> 32U),
+                static_cast<std::uint16_t>(snapshot.min) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(snapshot.max)) << 16U),
+                static_cast<std::uint32_t>(static_cast<std::uint64_t>(snapshot.sum)),
+                static_cast<std::uint32_t>(static_cast<std::uint64_t>(snapshot.sum) >> 32U),
+                static_cast<std::uint32_t>(snapshot.start_us),
+                static_cast<std::uint32_t>(snapshot.start_us >> 32U),
+                static_cast<std::uint32_t>(snapshot.end_us),
+                static_cast<std::uint32_t>(snapshot.end_us >> 32U),
+                buckets};
+            if (!event_log.write_words(HISTOGRAM_RECORD_ID, words.data(), words.size())) {
+                return RUNTIME_ERR_OK;
+            }
+            histogram_stream.is_header_sent = true;
+        }
+
+        for (std::size_t record = 0U; record < HISTOGRAM_RECORDS_PER_RUN; ++record) {
+            std::array<std::uint32_t, 1U + 2U * HISTOGRAM_PAIRS_PER_RECORD> words{};
+            words[0] = (HISTOGRAM_RECORD_DATA << 24U) | sequence;
+            std::size_t count{1U};
+            std::size_t index = histogram_stream.index;
+            for (; index < HISTOGRAM_BUCKETS && count < words.size(); ++index) {
+                if (snapshot.counts[index] > 0U) {
+                    words[count++] = static_cast<std::uint32_t>(index);
+                    words[count++] = snapshot.counts[index];
+                }
+            }
+            if (count == 1U) {
+                histogram_stream.is_active = false;
+                return RUNTIME_ERR_OK;
+            }
+            if (!event_log.write_words(HISTOGRAM_RECORD_ID, words.data(), count)) {
+                return RUNTIME_ERR_OK;
+            }
+            histogram_stream.index = index;
+        }
+
+        return RUNTIME_ERR_OK;
+    }
+
+} // namespace app
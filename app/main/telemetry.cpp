@@ -0,0 +1,215 @@
+#include "app.hpp"
+#include "frame_pool.hpp"
+#include <array>
+#include <cstdint>
+
+namespace app {
+
+    runtime_err_t telemetry_task_handler(void*, std::uint32_t)
+    {
+        for (std::size_t i = 0U; i < acquisition.device_count; ++i) {
+            auto& stats = channel_stats[i];
+
+            if (stats.count > 0U) {
+                float32_t const count = static_cast<float32_t>(stats.count);
+                LOGGER_WRITE(event_log,
+                             "ch%u n=%lu errors=%lu bus=%.3fV i=%.4fA [%.4f..%.4f] p=%.4fW",
+                             static_cast<std::uint32_t>(i),
+                             stats.count,
+                             stats.errors,
+                             stats.bus_voltage_sum / count,
+                             stats.current_sum / count,
+                             stats.current_min,
+                             stats.current_max,
+                             stats.power_sum / count);
+            }
+            if (stats.filtered_blocks > 0U) {
+                LOGGER_WRITE(event_log,
+                             "ch%u filtered shunt [%.3f..%.3f]mV",
+                             static_cast<std::uint32_t>(i),
+                             stats.filtered_shunt_min * 1000.0F,
+                             stats.filtered_shunt_max * 1000.0F);
+            }
+
+            stats = {};
+        }
+
+        LOGGER_WRITE(event_log,
+                     "sampler ticks=%lu missed=%lu latency=%luus overruns=%lu alerts=%lu",
+                     sampler.ticks,
+                     sampler.missed_ticks,
+                     sampler.max_latency_us,
+                     sampler_overruns,
+                     alerts);
+        if (bus_channel < BUS_SCHEDULER_MAX_CHANNELS) {
+            auto const& scheduled = bus_scheduler.channels[bus_channel];
+            LOGGER_WRITE(event_log,
+                         "bus rate=%luHz missed=%lu skipped=%lu",
+                         scheduled.config.rate_hz,
+                         scheduled.missed_deadlines,
+                         scheduled.skipped_periods);
+        }
+
+        if (acquisition_mode == acquisition_mode_t::triggered) {
+            LOGGER_WRITE(event_log,
+                         "trigger batches=%lu errors=%lu skew avg=%luus max=%luus",
+                         trigger_stats.batches,
+                         trigger_stats.errors,
+                         trigger_stats.batches ? static_cast<std::uint32_t>(trigger_stats.skew_sum_us / trigger_stats.batches) : 0U,
+                         trigger_stats.max_skew_us);
+        }
+
+        auto const pipeline = acquisition_pipeline.get_stats();
+        LOGGER_WRITE(event_log,
+                     "pipeline blocks=%lu dropped=%lu errors=%lu util transfer=%lu decode=%lu aggregate=%lu ppm",
+                     pipeline.blocks,
+                     pipeline.dropped_blocks,
+                     pipeline.errors,
+                     async::pipeline::get_utilization_ppm(pipeline.transfer, pipeline.window_cycles),
+                     async::pipeline::get_utilization_ppm(pipeline.decode, pipeline.window_cycles),
+                     async::pipeline::get_utilization_ppm(pipeline.aggregate, pipeline.window_cycles));
+        LOGGER_WRITE(event_log,
+                     "pipeline latency avg=%lucyc max=%lucyc wire avg=%lucyc",
+                     pipeline.blocks ? static_cast<std::uint32_t>(pipeline.latency_cycles / pipeline.blocks) : 0U,
+                     pipeline.max_latency_cycles,
+                     pipeline.blocks ? static_cast<std::uint32_t>(pipeline.wire_cycles / pipeline.blocks) : 0U);
+        acquisition_pipeline.reset_stats();
+
+        for (std::size_t i = 0U; i < runtime.task_count; ++i) {
+            auto const& task = runtime.tasks[i];
+            LOGGER_WRITE(event_log,
+                         "task%u runs=%lu errors=%lu max=%lucyc avg=%lucyc",
+                         static_cast<std::uint32_t>(i),
+                         task.runs,
+                         task.errors,
+                         task.max_cycles,
+                         task.runs ? static_cast<std::uint32_t>(task.total_cycles / task.runs) : 0U);
+        }
+
+        LOGGER_WRITE(event_log,
+                     "async transfers=%lu errors=%lu failures=%lu",
+                     i2c1_bus.get_transfers(),
+                     i2c1_bus.get_errors(),
+                     executor.get_failures());
+
+        // %s arguments are stored as addresses, fine for the string literals naming allocators
+        auto const frames = async::frame_pool().get_stats();
+        auto const init = init_arena.get_stats();
+        LOGGER_WRITE(event_log,
+                     "memory frames=%u/%uB init=%u/%uB failures=%lu last=%s",
+                     static_cast<std::uint32_t>(frames.high_water),
+                     static_cast<std::uint32_t>(frames.capacity),
+                     static_cast<std::uint32_t>(init.high_water),
+                     static_cast<std::uint32_t>(init.capacity),
+                     memory_failures,
+                     memory_failure_name != nullptr ? memory_failure_name : "-");
+
+        auto const& exti = isr_profiles[ISR_PROFILE_EXTI9_5];
+        auto const& i2c_ev = isr_profiles[ISR_PROFILE_I2C1_EV];
+        LOGGER_WRITE(event_log,
+                     "isr exti max=%lucyc avg=%lucyc i2c_ev max=%lucyc avg=%lucyc i2c_er n=%lu",
+                     exti.max_cycles,
+                     exti.count ? exti.total_cycles / exti.count : 0U,
+                     i2c_ev.max_cycles,
+                     i2c_ev.count ? i2c_ev.total_cycles / i2c_ev.count : 0U,
+                     isr_profiles[ISR_PROFILE_I2C1_ER].count);
+
+        auto const log = event_log.get_stats();
+        LOGGER_WRITE(event_log,
+                     "log records=%lu dropped=%lu high_water=%uw",
+                     log.records,
+                     log.dropped,
+                     static_cast<std::uint32_t>(log.high_water_words));
+        event_log.reset_stats();
+
+        LOGGER_WRITE(event_log,
+                     "adaptive step=%u/%u bw=%luHz ratio=%.2f changes=%lu",
+                     static_cast<std::uint32_t>(adaptive.step),
+                     static_cast<std::uint32_t>(adaptive.max_step),
+                     adaptive.config.bandwidth_hz,
+                     adaptive.last_ratio,
+                     adaptive.changes);
+
+        for (std::size_t i = 0U; i < acquisition.device_count; ++i) {
+            LOGGER_WRITE(event_log,
+                         "filter ch%u saturations fir=%lu notch=%lu",
+                         static_cast<std::uint32_t>(i),
+                         shunt_filters[i].fir.saturations,
+                         shunt_filters[i].notch.saturations);
+        }
+        LOGGER_WRITE(event_log,
+                     "filter block=%u max=%lucyc",
+                     static_cast<std::uint32_t>(SHUNT_FILTER_BLOCK),
+                     shunt_filter_max_cycles);
+        shunt_filter_max_cycles = 0U;
+
+        LOGGER_WRITE(event_log,
+                     "alert fn=%u limit=%.4f latched=%u n=%lu latency min=%luus avg=%luus max=%luus",
+                     static_cast<std::uint32_t>(alert_setting.function),
+                     alert_setting.limit,
+                     static_cast<std::uint32_t>(alert_setting.is_latched),
+                     alert.latency_count,
+                     alert.latency_min_us,
+                     alert.latency_count ? static_cast<std::uint32_t>(alert.latency_total_us / alert.latency_count) : 0U,
+                     alert.latency_max_us);
+        LOGGER_WRITE(event_log,
+                     "alert asserted=%u hysteresis=%u trigger=0x%04x release=0x%04x chatter=%lu rate_limits=%lu",
+                     static_cast<std::uint32_t>(alert_is_asserted(&alert)),
+                     static_cast<std::uint32_t>(alert.is_hysteresis_enabled),
+                     static_cast<std::uint32_t>(alert.trigger_word),
+                     static_cast<std::uint32_t>(alert.release_word),
+                     alert.chatter_edges,
+                     alert.rate_limits);
+
+        if (is_transient_enabled) {
+            for (std::size_t i = 0U; i < acquisition.device_count; ++i) {
+                LOGGER_WRITE(event_log,
+                             "transient ch%u baseline=%d events=%lu dropped=%lu",
+                             static_cast<std::uint32_t>(i),
+                             static_cast<std::int32_t>(transient_get_baseline(&transients[i])),
+                             transients[i].events,
+                             transients[i].dropped);
+            }
+        }
+
+        constexpr float32_t MA_PER_LSB = INA226_SHUNT_VOLTAGE_SCALE / SHUNT_RESISTANCE_OHM * 1000.0F;
+        std::array<std::int16_t, 3U> quantiles{};
+        if (histogram_get_quantile(&shunt_histogram, 500000U, &quantiles[0]) == HISTOGRAM_ERR_OK &&
+            histogram_get_quantile(&shunt_histogram, 990000U, &quantiles[1]) == HISTOGRAM_ERR_OK &&
+            histogram_get_quantile(&shunt_histogram, 999000U, &quantiles[2]) == HISTOGRAM_ERR_OK) {
+            LOGGER_WRITE(event_log,
+                         "histogram ch%u n=%llu p50=%.3fmA p99=%.3fmA p99.9=%.3fmA max=%.3fmA",
+                         static_cast<std::uint32_t>(HISTOGRAM_CHANNEL),
+                         shunt_histogram.total,
+                         static_cast<float32_t>(quantiles[0]) * MA_PER_LSB,
+                         static_cast<float32_t>(quantiles[1]) * MA_PER_LSB,
+                         static_cast<float32_t>(quantiles[2]) * MA_PER_LSB,
+                         static_cast<float32_t>(shunt_histogram.max) * MA_PER_LSB);
+        }
+
+        if (is_segmenter_enabled) {
+            LOGGER_WRITE(event_log,
+                         "segmenter state=%u segments=%lu dropped=%lu",
+                         static_cast<std::uint32_t>(segmenter.state),
+                         segmenter.closed,
+                         segmenter.dropped);
+            for (std::size_t i = 0U; i < segmenter.config.state_count; ++i) {
+                LOGGER_WRITE(event_log,
+                             "segmenter state%u residency=%llums",
+                             static_cast<std::uint32_t>(i),
+                             segmenter.residency_us[i] / 1000U);
+            }
+        }
+
+        LOGGER_WRITE(event_log,
+                     "capture state=%u captures=%lu missed=%lu",
+                     static_cast<std::uint32_t>(capture.state),
+                     capture.captures,
+                     capture.missed_triggers);
+
+        LOGGER_WRITE(event_log, "idle runs=%lu cycles=%llu", runtime.idle_runs, runtime.idle_cycles);
+
+        return RUNTIME_ERR_OK;
+    }
+
+} // namespace app
@@ -0,0 +1,34 @@
+#include "arena.hpp"
+
+namespace memory {
+
+    void* arena::allocate(std::size_t size, std::size_t alignment) noexcept
+    {
+        // alignment is a power of two, so rounding up is a mask
+        std::size_t const start = (offset_ + alignment - 1U) & ~(alignment - 1U);
+
+        if (alignment == 0U || (alignment & (alignment - 1U)) != 0U || start > size_ || size > size_ - start) {
+            ++failures_;
+            report_failure(name_, size, alignment);
+            return nullptr;
+        }
+
+        offset_ = start + size;
+        if (offset_ > high_water_) {
+            high_water_ = offset_;
+        }
+
+        return storage_ + start;
+    }
+
+    void arena::reset() noexcept
+    {
+        offset_ = 0U;
+    }
+
+    stats arena::get_stats() const noexcept
+    {
+        return {.capacity = size_, .used = offset_, .high_water = high_water_, .failures = failures_};
+    }
+
+} // namespace memory
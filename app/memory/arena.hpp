@@ -0,0 +1,55 @@
+#ifndef MEMORY_ARENA_HPP
+#define MEMORY_ARENA_HPP
+
+#include "memory_config.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace memory {
+
+    // monotonic bump allocator for objects that live as long as the application, typically set
+    // up during init; nothing is released short of reset()
+    class arena {
+    public:
+        constexpr arena(char const* name, std::byte* storage, std::size_t size) noexcept :
+            name_{name}, storage_{storage}, size_{size}
+        {}
+
+        arena(arena const&) = delete;
+        arena& operator=(arena const&) = delete;
+
+        [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+        // invalidates everything handed out so far
+        void reset() noexcept;
+
+        [[nodiscard]] char const* get_name() const noexcept
+        {
+            return name_;
+        }
+
+        [[nodiscard]] stats get_stats() const noexcept;
+
+    private:
+        char const* name_;
+        std::byte* storage_;
+        std::size_t size_;
+
+        std::size_t offset_{0U};
+        std::size_t high_water_{0U};
+        std::uint32_t failures_{0U};
+    };
+
+    template <std::size_t Size>
+    class static_arena : public arena {
+    public:
+        explicit constexpr static_arena(char const* name) noexcept : arena{name, storage_, Size}
+        {}
+
+    private:
+        alignas(std::max_align_t) std::byte storage_[Size]{};
+    };
+
+} // namespace memory
+
+#endif // MEMORY_ARENA_HPP
@@ -0,0 +1,64 @@
+#include "block_pool.hpp"
+
+namespace memory {
+
+    void* block_pool::allocate(std::size_t size, std::size_t alignment) noexcept
+    {
+        void* block = nullptr;
+
+        if (size <= block_size_ && alignment <= alignof(std::max_align_t)) {
+            if (free_ != nullptr) {
+                block = free_;
+                free_ = free_->next;
+            } else if (untouched_ < block_count_) {
+                block = storage_ + untouched_++ * block_size_;
+            }
+        }
+
+        if (block == nullptr) {
+            ++failures_;
+            report_failure(name_, size, alignment);
+            return nullptr;
+        }
+
+        if (++used_ > high_water_) {
+            high_water_ = used_;
+        }
+
+        return block;
+    }
+
+    void block_pool::deallocate(void* block) noexcept
+    {
+        if (block == nullptr) {
+            return;
+        }
+
+        auto* released = static_cast<free_block*>(block);
+        released->next = free_;
+        free_ = released;
+
+        --used_;
+    }
+
+    bool block_pool::owns(void const* block) const noexcept
+    {
+        auto const* address = static_cast<std::byte const*>(block);
+
+        return address >= storage_ && address < storage_ + block_size_ * block_count_;
+    }
+
+    stats block_pool::get_stats() const noexcept
+    {
+        return {.capacity = block_size_ * block_count_,
+                .used = used_ * block_size_,
+                .high_water = high_water_ * block_size_,
+                .failures = failures_};
+    }
+
+    void block_pool::reset_high_water() noexcept
+    {
+        high_water_ = used_;
+    }
+
+} // namespace memory
@@ -0,0 +1,73 @@
+#ifndef MEMORY_BLOCK_POOL_HPP
+#define MEMORY_BLOCK_POOL_HPP
+
+#include "memory_config.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace memory {
+
+    // fixed-size blocks over caller-provided storage; O(1) allocate and release, no locking, so
+    // a pool belongs to a single context (main loop or one interrupt)
+    class block_pool {
+    public:
+        constexpr block_pool(char const* name, std::byte* storage, std::size_t block_size, std::size_t block_count) noexcept :
+            name_{name}, storage_{storage}, block_size_{block_size}, block_count_{block_count}
+        {}
+
+        block_pool(block_pool const&) = delete;
+        block_pool& operator=(block_pool const&) = delete;
+
+        [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+        void deallocate(void* block) noexcept;
+
+        [[nodiscard]] bool owns(void const* block) const noexcept;
+
+        [[nodiscard]] std::size_t get_block_size() const noexcept
+        {
+            return block_size_;
+        }
+
+        [[nodiscard]] char const* get_name() const noexcept
+        {
+            return name_;
+        }
+
+        [[nodiscard]] stats get_stats() const noexcept;
+        void reset_high_water() noexcept;
+
+    private:
+        struct free_block {
+            free_block* next;
+        };
+
+        char const* name_;
+        std::byte* storage_;
+        std::size_t block_size_;
+        std::size_t block_count_;
+
+        free_block* free_{nullptr};
+        // blocks past this index were never handed out, so the free list needs no setup pass
+        std::size_t untouched_{0U};
+
+        std::size_t used_{0U};
+        std::size_t high_water_{0U};
+        std::uint32_t failures_{0U};
+    };
+
+    template <std::size_t BlockSize, std::size_t BlockCount>
+    class static_block_pool : public block_pool {
+    public:
+        static_assert(BlockSize >= sizeof(void*) && BlockSize % alignof(std::max_align_t) == 0U);
+
+        explicit constexpr static_block_pool(char const* name) noexcept :
+            block_pool{name, storage_, BlockSize, BlockCount}
+        {}
+
+    private:
+        alignas(std::max_align_t) std::byte storage_[BlockSize * BlockCount]{};
+    };
+
+} // namespace memory
+
+#endif // MEMORY_BLOCK_POOL_HPP
@@ -0,0 +1,25 @@
+#include "memory_config.hpp"
+
+namespace memory {
+
+    namespace {
+
+        constinit failure_hook hook_handler{nullptr};
+        constinit void* hook_user{nullptr};
+
+    } // namespace
+
+    void set_failure_hook(failure_hook hook, void* user) noexcept
+    {
+        hook_handler = hook;
+        hook_user = user;
+    }
+
+    void report_failure(char const* name, std::size_t size, std::size_t alignment) noexcept
+    {
+        if (hook_handler != nullptr) {
+            hook_handler(hook_user, name, size, alignment);
+        }
+    }
+
+} // namespace memory
@@ -0,0 +1,32 @@
+#ifndef MEMORY_MEMORY_CONFIG_HPP
+#define MEMORY_MEMORY_CONFIG_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace memory {
+
+    enum struct err : std::uint8_t {
+        ok = 0,
+        fail = 1 << 0,
+        null = 1 << 1,
+        capacity = 1 << 2,
+    };
+
+    struct stats {
+        std::size_t capacity;
+        std::size_t used;
+        std::size_t high_water;
+        std::uint32_t failures;
+    };
+
+    // called on every failed allocation with the allocator name and the request; a hook that
+    // returns makes the allocation yield nullptr
+    using failure_hook = void (*)(void* user, char const* name, std::size_t size, std::size_t alignment);
+
+    void set_failure_hook(failure_hook hook, void* user) noexcept;
+    void report_failure(char const* name, std::size_t size, std::size_t alignment) noexcept;
+
+} // namespace memory
+
+#endif // MEMORY_MEMORY_CONFIG_HPP
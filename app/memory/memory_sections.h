@@ -0,0 +1,28 @@
+#ifndef MEMORY_MEMORY_SECTIONS_H
+#define MEMORY_MEMORY_SECTIONS_H
+
+// placement in the 32K SRAM2 at 0x10000000, a separate bus matrix slave from the 96K SRAM1, so
+// ISR state and DMA buffers kept there do not contend with processing code working in SRAM1;
+// MEMORY_SRAM2 objects keep their initializer (copied from flash by the startup code), while
+// MEMORY_SRAM2_BSS objects must be zero-initialized and are cleared by the startup code
+
+// define MEMORY_NO_SRAM2 to build everything into SRAM1 again, e.g. for A/B latency measurements
+#ifdef MEMORY_NO_SRAM2
+#define MEMORY_SRAM2
+#define MEMORY_SRAM2_BSS
+#else
+#define MEMORY_SRAM2 __attribute__((section(".sram2.data")))
+#define MEMORY_SRAM2_BSS __attribute__((section(".sram2.bss")))
+#endif
+
+// code in the .ramfunc section is copied to SRAM2 by the startup code and fetched over the
+// I-Code bus from the 0x10000000 alias, so interrupt paths avoid the four flash wait states
+// on ART cache misses; define MEMORY_NO_RAMFUNC to keep the annotated functions in flash (the
+// HAL interrupt paths the linker script lists by name move regardless)
+#ifdef MEMORY_NO_RAMFUNC
+#define MEMORY_RAMFUNC
+#else
+#define MEMORY_RAMFUNC __attribute__((section(".ramfunc")))
+#endif
+
+#endif // MEMORY_MEMORY_SECTIONS_H
@@ -0,0 +1,61 @@
+#include "resource.hpp"
+
+namespace memory {
+
+    namespace {
+
+        class failing_resource final : public std::pmr::memory_resource {
+        private:
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override
+            {
+                report_failure("null", bytes, alignment);
+                return nullptr;
+            }
+
+            void do_deallocate(void*, std::size_t, std::size_t) override
+            {}
+
+            bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+        constinit failing_resource failing{};
+
+    } // namespace
+
+    void* pool_resource::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        return pool_.allocate(bytes, alignment);
+    }
+
+    void pool_resource::do_deallocate(void* block, std::size_t, std::size_t)
+    {
+        pool_.deallocate(block);
+    }
+
+    bool pool_resource::do_is_equal(std::pmr::memory_resource const& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    void* arena_resource::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        return arena_.allocate(bytes, alignment);
+    }
+
+    void arena_resource::do_deallocate(void*, std::size_t, std::size_t)
+    {}
+
+    bool arena_resource::do_is_equal(std::pmr::memory_resource const& other) const noexcept
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* null_resource() noexcept
+    {
+        return &failing;
+    }
+
+} // namespace memory
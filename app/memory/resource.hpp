@@ -0,0 +1,47 @@
+#ifndef MEMORY_RESOURCE_HPP
+#define MEMORY_RESOURCE_HPP
+
+#include "arena.hpp"
+#include "block_pool.hpp"
+#include <cstddef>
+#include <memory_resource>
+
+namespace memory {
+
+    // std::pmr adaptors; exceptions are off, so a failed allocation goes through the failure
+    // hook and then hands nullptr to the container, which the hook should not let happen
+    class pool_resource final : public std::pmr::memory_resource {
+    public:
+        explicit pool_resource(block_pool& pool) noexcept : pool_{pool}
+        {}
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+
+        block_pool& pool_;
+    };
+
+    // deallocate is a no-op, as with std::pmr::monotonic_buffer_resource, but without an
+    // upstream to fall back on
+    class arena_resource final : public std::pmr::memory_resource {
+    public:
+        explicit arena_resource(arena& source) noexcept : arena_{source}
+        {}
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* block, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override;
+
+        arena& arena_;
+    };
+
+    // resource that fails every request, to install as the pmr default so any container
+    // left without an explicit resource is caught instead of reaching the heap
+    [[nodiscard]] std::pmr::memory_resource* null_resource() noexcept;
+
+} // namespace memory
+
+#endif // MEMORY_RESOURCE_HPP
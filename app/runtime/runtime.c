@@ -0,0 +1,272 @@
+#include "runtime.h"
+#include <assert.h>
+#include <string.h>
+
+static runtime_err_t runtime_get_time_us(runtime_t const* runtime, uint64_t* time_us)
+{
+    return runtime->interface.get_time_us
+               ? runtime->interface.get_time_us(runtime->interface.user, time_us)
+               : RUNTIME_ERR_NULL;
+}
+
+static uint32_t runtime_get_cycles(runtime_t const* runtime)
+{
+    uint32_t cycles = 0U;
+
+    if (runtime->interface.get_cycles) {
+        runtime->interface.get_cycles(runtime->interface.user, &cycles);
+    }
+
+    return cycles;
+}
+
+static void runtime_critical_enter(runtime_t const* runtime)
+{
+    if (runtime->interface.critical_enter) {
+        runtime->interface.critical_enter(runtime->interface.user);
+    }
+}
+
+static void runtime_critical_exit(runtime_t const* runtime)
+{
+    if (runtime->interface.critical_exit) {
+        runtime->interface.critical_exit(runtime->interface.user);
+    }
+}
+
+static void runtime_idle(runtime_t const* runtime, uint64_t wakeup_us)
+{
+    if (runtime->interface.idle) {
+        runtime->interface.idle(runtime->interface.user, wakeup_us);
+    }
+}
+
+static void runtime_insert_timer(runtime_t* runtime, uint8_t index)
+{
+    runtime_timer_t* timer = &runtime->timers[index];
+    uint8_t* link = &runtime->timer_head;
+
+    while (*link != RUNTIME_TIMER_NONE &&
+           runtime->timers[*link].deadline_us <= timer->deadline_us) {
+        link = &runtime->timers[*link].next;
+    }
+
+    timer->next = *link;
+    *link = index;
+}
+
+static void runtime_remove_timer(runtime_t* runtime, uint8_t index)
+{
+    uint8_t* link = &runtime->timer_head;
+
+    while (*link != RUNTIME_TIMER_NONE) {
+        if (*link == index) {
+            *link = runtime->timers[index].next;
+            runtime->timers[index].next = RUNTIME_TIMER_NONE;
+            return;
+        }
+        link = &runtime->timers[*link].next;
+    }
+}
+
+static void runtime_fire_timers(runtime_t* runtime, uint64_t now_us)
+{
+    while (runtime->timer_head != RUNTIME_TIMER_NONE) {
+        uint8_t index = runtime->timer_head;
+        runtime_timer_t* timer = &runtime->timers[index];
+
+        if (timer->deadline_us > now_us) {
+            break;
+        }
+
+        runtime->timer_head = timer->next;
+        runtime_set_events(runtime, timer->task, timer->events);
+
+        if (timer->period_us == 0U) {
+            timer->is_active = false;
+            timer->next = RUNTIME_TIMER_NONE;
+            continue;
+        }
+
+        timer->deadline_us += timer->period_us;
+        if (timer->deadline_us <= now_us) {
+            timer->deadline_us = now_us + timer->period_us;
+        }
+        runtime_insert_timer(runtime, index);
+    }
+}
+
+static bool runtime_has_pending_events(runtime_t const* runtime)
+{
+    for (size_t i = 0U; i < runtime->task_count; ++i) {
+        if (runtime->tasks[i].events != 0U) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+runtime_err_t runtime_initialize(runtime_t* runtime, runtime_interface_t const* interface)
+{
+    assert(runtime && interface);
+
+    memset(runtime, 0, sizeof(*runtime));
+    memcpy(&runtime->interface, interface, sizeof(*interface));
+
+    runtime->timer_head = RUNTIME_TIMER_NONE;
+    for (size_t i = 0U; i < RUNTIME_MAX_TIMERS; ++i) {
+        runtime->timers[i].next = RUNTIME_TIMER_NONE;
+    }
+
+    return RUNTIME_ERR_OK;
+}
+
+runtime_err_t runtime_deinitialize(runtime_t* runtime)
+{
+    assert(runtime);
+
+    memset(runtime, 0, sizeof(*runtime));
+
+    return RUNTIME_ERR_OK;
+}
+
+runtime_err_t runtime_add_task(runtime_t* runtime,
+                               runtime_task_handler_t handler,
+                               void* user,
+                               size_t* index)
+{
+    assert(runtime && handler && index);
+
+    if (runtime->task_count == RUNTIME_MAX_TASKS) {
+        return RUNTIME_ERR_FAIL;
+    }
+
+    runtime_task_t* task = &runtime->tasks[runtime->task_count];
+    memset(task, 0, sizeof(*task));
+    task->handler = handler;
+    task->user = user;
+
+    *index = runtime->task_count++;
+
+    return RUNTIME_ERR_OK;
+}
+
+void runtime_set_events(runtime_t* runtime, size_t task, uint32_t events)
+{
+    assert(runtime && task < RUNTIME_MAX_TASKS);
+
+    __atomic_fetch_or(&runtime->tasks[task].events, events, __ATOMIC_RELEASE);
+}
+
+runtime_err_t runtime_add_timer(runtime_t* runtime,
+                                size_t task,
+                                uint32_t events,
+                                uint32_t delay_us,
+                                uint32_t period_us,
+                                size_t* index)
+{
+    assert(runtime && index);
+
+    if (task >= runtime->task_count) {
+        return RUNTIME_ERR_FAIL;
+    }
+
+    uint64_t now_us = {};
+    runtime_err_t err = runtime_get_time_us(runtime, &now_us);
+    if (err != RUNTIME_ERR_OK) {
+        return err;
+    }
+
+    for (uint8_t i = 0U; i < RUNTIME_MAX_TIMERS; ++i) {
+        runtime_timer_t* timer = &runtime->timers[i];
+        if (timer->is_active) {
+            continue;
+        }
+
+        timer->is_active = true;
+        timer->task = (uint8_t)task;
+        timer->events = events;
+        timer->period_us = period_us;
+        timer->deadline_us = now_us + delay_us;
+        runtime_insert_timer(runtime, i);
+
+        *index = i;
+        return RUNTIME_ERR_OK;
+    }
+
+    return RUNTIME_ERR_FAIL;
+}
+
+runtime_err_t runtime_cancel_timer(runtime_t* runtime, size_t index)
+{
+    assert(runtime);
+
+    if (index >= RUNTIME_MAX_TIMERS || !runtime->timers[index].is_active) {
+        return RUNTIME_ERR_FAIL;
+    }
+
+    runtime_remove_timer(runtime, (uint8_t)index);
+    runtime->timers[index].is_active = false;
+
+    return RUNTIME_ERR_OK;
+}
+
+runtime_err_t runtime_run_once(runtime_t* runtime)
+{
+    assert(runtime);
+
+    uint64_t now_us = {};
+    runtime_err_t err = runtime_get_time_us(runtime, &now_us);
+    if (err != RUNTIME_ERR_OK) {
+        return err;
+    }
+
+    runtime_fire_timers(runtime, now_us);
+
+    for (size_t i = 0U; i < runtime->task_count; ++i) {
+        runtime_task_t* task = &runtime->tasks[i];
+
+        uint32_t events = __atomic_exchange_n(&task->events, 0U, __ATOMIC_ACQ_REL);
+        if (events == 0U) {
+            continue;
+        }
+
+        uint32_t start = runtime_get_cycles(runtime);
+        if (task->handler(task->user, events) != RUNTIME_ERR_OK) {
+            ++task->errors;
+        }
+        uint32_t cycles = runtime_get_cycles(runtime) - start;
+
+        ++task->runs;
+        task->total_cycles += cycles;
+        if (cycles > task->max_cycles) {
+            task->max_cycles = cycles;
+        }
+    }
+
+    // events raised between the check and the idle hook still wake it, as interrupts stay
+    // pending while masked
+    runtime_critical_enter(runtime);
+    if (!runtime_has_pending_events(runtime)) {
+        uint64_t wakeup_us = runtime->timer_head != RUNTIME_TIMER_NONE
+                                 ? runtime->timers[runtime->timer_head].deadline_us
+                                 : UINT64_MAX;
+        uint32_t start = runtime_get_cycles(runtime);
+        runtime_idle(runtime, wakeup_us);
+        runtime->idle_cycles += runtime_get_cycles(runtime) - start;
+        ++runtime->idle_runs;
+    }
+    runtime_critical_exit(runtime);
+
+    return RUNTIME_ERR_OK;
+}
+
+void runtime_run(runtime_t* runtime)
+{
+    assert(runtime);
+
+    while (1) {
+        runtime_run_once(runtime);
+    }
+}
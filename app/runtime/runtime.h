@@ -0,0 +1,64 @@
+#ifndef RUNTIME_RUNTIME_H
+#define RUNTIME_RUNTIME_H
+
+#include "runtime_config.h"
+
+typedef struct {
+    runtime_task_handler_t handler;
+    void* user;
+    volatile uint32_t events;
+
+    uint32_t runs;
+    uint32_t errors;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} runtime_task_t;
+
+typedef struct {
+    bool is_active;
+    uint8_t next;
+    uint8_t task;
+    uint32_t events;
+    uint32_t period_us;
+    uint64_t deadline_us;
+} runtime_timer_t;
+
+typedef struct {
+    runtime_interface_t interface;
+
+    runtime_task_t tasks[RUNTIME_MAX_TASKS];
+    size_t task_count;
+
+    runtime_timer_t timers[RUNTIME_MAX_TIMERS];
+    uint8_t timer_head;
+
+    uint32_t idle_runs;
+    uint64_t idle_cycles;
+} runtime_t;
+
+runtime_err_t runtime_initialize(runtime_t* runtime, runtime_interface_t const* interface);
+runtime_err_t runtime_deinitialize(runtime_t* runtime);
+
+// tasks run in registration order, so register the most latency-sensitive one first
+runtime_err_t runtime_add_task(runtime_t* runtime,
+                               runtime_task_handler_t handler,
+                               void* user,
+                               size_t* index);
+
+// safe to call from interrupt context
+void runtime_set_events(runtime_t* runtime, size_t task, uint32_t events);
+
+// period_us of 0 makes a one-shot timer
+runtime_err_t runtime_add_timer(runtime_t* runtime,
+                                size_t task,
+                                uint32_t events,
+                                uint32_t delay_us,
+                                uint32_t period_us,
+                                size_t* index);
+runtime_err_t runtime_cancel_timer(runtime_t* runtime, size_t index);
+
+// fires expired timers, runs every task with pending events once, and idles when none are left
+runtime_err_t runtime_run_once(runtime_t* runtime);
+void runtime_run(runtime_t* runtime);
+
+#endif // RUNTIME_RUNTIME_H
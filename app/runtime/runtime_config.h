@@ -0,0 +1,29 @@
+#ifndef RUNTIME_RUNTIME_CONFIG_H
+#define RUNTIME_RUNTIME_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RUNTIME_MAX_TASKS 8U
+#define RUNTIME_MAX_TIMERS 8U
+#define RUNTIME_TIMER_NONE 0xFFU
+
+typedef enum {
+    RUNTIME_ERR_OK = 0,
+    RUNTIME_ERR_FAIL = 1 << 0,
+    RUNTIME_ERR_NULL = 1 << 1,
+} runtime_err_t;
+
+typedef runtime_err_t (*runtime_task_handler_t)(void*, uint32_t);
+
+typedef struct {
+    void* user;
+    runtime_err_t (*get_time_us)(void*, uint64_t*);
+    runtime_err_t (*get_cycles)(void*, uint32_t*);
+    void (*critical_enter)(void*);
+    void (*critical_exit)(void*);
+    void (*idle)(void*, uint64_t);
+} runtime_interface_t;
+
+#endif // RUNTIME_RUNTIME_CONFIG_H
@@ -0,0 +1,158 @@
+#include "sampler.h"
+#include <assert.h>
+#include <string.h>
+
+static sampler_err_t sampler_timer_start(sampler_t const* sampler, uint32_t period_us)
+{
+    return sampler->interface.timer_start
+               ? sampler->interface.timer_start(sampler->interface.timer_user, period_us)
+               : SAMPLER_ERR_NULL;
+}
+
+static sampler_err_t sampler_timer_stop(sampler_t const* sampler)
+{
+    return sampler->interface.timer_stop
+               ? sampler->interface.timer_stop(sampler->interface.timer_user)
+               : SAMPLER_ERR_NULL;
+}
+
+static sampler_err_t sampler_timer_get_count(sampler_t const* sampler, uint32_t* count)
+{
+    return sampler->interface.timer_get_count
+               ? sampler->interface.timer_get_count(sampler->interface.timer_user, count)
+               : SAMPLER_ERR_NULL;
+}
+
+static sampler_err_t sampler_timer_is_overflow_pending(sampler_t const* sampler, bool* is_pending)
+{
+    if (sampler->interface.timer_is_overflow_pending == NULL) {
+        *is_pending = false;
+        return SAMPLER_ERR_OK;
+    }
+
+    return sampler->interface.timer_is_overflow_pending(sampler->interface.timer_user, is_pending);
+}
+
+sampler_err_t sampler_initialize(sampler_t* sampler,
+                                 sampler_config_t const* config,
+                                 sampler_interface_t const* interface)
+{
+    assert(sampler && config && interface);
+
+    if (config->period_us == 0U) {
+        return SAMPLER_ERR_FAIL;
+    }
+
+    memset(sampler, 0, sizeof(*sampler));
+    memcpy(&sampler->config, config, sizeof(*config));
+    memcpy(&sampler->interface, interface, sizeof(*interface));
+
+    return SAMPLER_ERR_OK;
+}
+
+sampler_err_t sampler_deinitialize(sampler_t* sampler)
+{
+    assert(sampler);
+
+    sampler_err_t err = sampler_timer_stop(sampler);
+
+    memset(sampler, 0, sizeof(*sampler));
+
+    return err;
+}
+
+sampler_err_t sampler_start(sampler_t* sampler)
+{
+    assert(sampler);
+
+    sampler_err_t err = sampler_get_time_us(sampler, &sampler->start_us);
+    if (err != SAMPLER_ERR_OK) {
+        return err;
+    }
+
+    sampler->tick_us = sampler->start_us;
+    sampler->ticks = 0U;
+    sampler->missed_ticks = 0U;
+    sampler->max_latency_us = 0U;
+    __atomic_store_n(&sampler->pending_ticks, 0U, __ATOMIC_RELEASE);
+
+    return sampler_timer_start(sampler, sampler->config.period_us);
+}
+
+sampler_err_t sampler_stop(sampler_t* sampler)
+{
+    assert(sampler);
+
+    return sampler_timer_stop(sampler);
+}
+
+sampler_err_t sampler_get_time_us(sampler_t const* sampler, uint64_t* time_us)
+{
+    assert(sampler && time_us);
+
+    uint32_t seen = {};
+    uint32_t overflows = {};
+    uint32_t count = {};
+    sampler_err_t err = {};
+
+    // retry if the overflow interrupt ran in between; a wrap it has not serviced yet, e.g.
+    // with interrupts masked or from a handler it cannot preempt, shows as a pending flag, and
+    // the count read after the flag is then past the wrap
+    do {
+        bool is_pending = false;
+
+        seen = sampler->overflows;
+        overflows = seen;
+        err = sampler_timer_get_count(sampler, &count);
+        err |= sampler_timer_is_overflow_pending(sampler, &is_pending);
+        if (err == SAMPLER_ERR_OK && is_pending) {
+            err |= sampler_timer_get_count(sampler, &count);
+            ++overflows;
+        }
+    } while (err == SAMPLER_ERR_OK && seen != sampler->overflows);
+
+    *time_us = ((uint64_t)overflows << 32U) | count;
+
+    return err;
+}
+
+sampler_err_t sampler_take_ticks(sampler_t* sampler, uint32_t* ticks)
+{
+    assert(sampler && ticks);
+
+    uint32_t pending = __atomic_exchange_n(&sampler->pending_ticks, 0U, __ATOMIC_ACQ_REL);
+    *ticks = pending;
+    if (pending == 0U) {
+        return SAMPLER_ERR_OK;
+    }
+
+    sampler->missed_ticks += pending - 1U;
+    sampler->ticks += pending;
+    sampler->tick_us = sampler->start_us + (uint64_t)sampler->ticks * sampler->config.period_us;
+
+    uint64_t now_us = {};
+    sampler_err_t err = sampler_get_time_us(sampler, &now_us);
+    if (err != SAMPLER_ERR_OK) {
+        return err;
+    }
+
+    if (now_us > sampler->tick_us && now_us - sampler->tick_us > sampler->max_latency_us) {
+        sampler->max_latency_us = (uint32_t)(now_us - sampler->tick_us);
+    }
+
+    return pending > 1U ? SAMPLER_ERR_OVERRUN : SAMPLER_ERR_OK;
+}
+
+void sampler_timer_overflow_callback(sampler_t* sampler)
+{
+    assert(sampler);
+
+    __atomic_fetch_add(&sampler->overflows, 1U, __ATOMIC_RELEASE);
+}
+
+void sampler_period_elapsed_callback(sampler_t* sampler)
+{
+    assert(sampler);
+
+    __atomic_fetch_add(&sampler->pending_ticks, 1U, __ATOMIC_RELEASE);
+}
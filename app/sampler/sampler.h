@@ -0,0 +1,39 @@
+#ifndef SAMPLER_SAMPLER_H
+#define SAMPLER_SAMPLER_H
+
+#include "sampler_config.h"
+
+typedef struct {
+    sampler_config_t config;
+    sampler_interface_t interface;
+
+    volatile uint32_t overflows;
+    volatile uint32_t pending_ticks;
+
+    uint64_t start_us;
+    uint64_t tick_us;
+    uint32_t ticks;
+    uint32_t missed_ticks;
+    uint32_t max_latency_us;
+} sampler_t;
+
+sampler_err_t sampler_initialize(sampler_t* sampler,
+                                 sampler_config_t const* config,
+                                 sampler_interface_t const* interface);
+sampler_err_t sampler_deinitialize(sampler_t* sampler);
+
+sampler_err_t sampler_start(sampler_t* sampler);
+sampler_err_t sampler_stop(sampler_t* sampler);
+
+// 1 MHz free-running 32-bit counter extended to 64 bits with the overflow count; also valid
+// with interrupts masked when the interface reports a pending overflow
+sampler_err_t sampler_get_time_us(sampler_t const* sampler, uint64_t* time_us);
+
+// consumes the pending period events and updates the tick bookkeeping, the caller does the
+// reads; SAMPLER_ERR_OVERRUN if periods were missed
+sampler_err_t sampler_take_ticks(sampler_t* sampler, uint32_t* ticks);
+
+void sampler_timer_overflow_callback(sampler_t* sampler);
+void sampler_period_elapsed_callback(sampler_t* sampler);
+
+#endif // SAMPLER_SAMPLER_H
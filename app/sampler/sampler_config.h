@@ -0,0 +1,29 @@
+#ifndef SAMPLER_SAMPLER_CONFIG_H
+#define SAMPLER_SAMPLER_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    SAMPLER_ERR_OK = 0,
+    SAMPLER_ERR_FAIL = 1 << 0,
+    SAMPLER_ERR_NULL = 1 << 1,
+    SAMPLER_ERR_OVERRUN = 1 << 2,
+} sampler_err_t;
+
+typedef struct {
+    uint32_t period_us;
+} sampler_config_t;
+
+typedef struct {
+    void* timer_user;
+    sampler_err_t (*timer_start)(void*, uint32_t);
+    sampler_err_t (*timer_stop)(void*);
+    sampler_err_t (*timer_get_count)(void*, uint32_t*);
+    // whether the counter wrapped without the overflow interrupt having run yet; optional,
+    // without it the time is only valid where that interrupt can preempt the caller
+    sampler_err_t (*timer_is_overflow_pending)(void*, bool*);
+} sampler_interface_t;
+
+#endif // SAMPLER_SAMPLER_CONFIG_H
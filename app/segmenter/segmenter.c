@@ -0,0 +1,190 @@
+#include "segmenter.h"
+#include <assert.h>
+#include <string.h>
+
+// compensated summation; the error term is the part of the last addition that got rounded off
+static void segmenter_add_energy(segmenter_run_t* run, float32_t energy)
+{
+    float32_t const corrected = energy - run->energy_error;
+    float32_t const sum = run->energy + corrected;
+    run->energy_error = (sum - run->energy) - corrected;
+    run->energy = sum;
+}
+
+static void segmenter_start_run(segmenter_run_t* run, uint64_t timestamp_us)
+{
+    memset(run, 0, sizeof(*run));
+    run->start_us = timestamp_us;
+}
+
+static void segmenter_add_sample(segmenter_run_t* run, int16_t shunt, float32_t power, uint32_t dt_us)
+{
+    if (run->samples == 0U || shunt < run->shunt_min) {
+        run->shunt_min = shunt;
+    }
+    if (run->samples == 0U || shunt > run->shunt_max) {
+        run->shunt_max = shunt;
+    }
+    run->shunt_us += (int64_t)shunt * dt_us;
+    segmenter_add_energy(run, power * (float32_t)dt_us * 1e-6F);
+    ++run->samples;
+}
+
+// appends a run that directly follows the other one
+static void segmenter_merge_run(segmenter_run_t* run, segmenter_run_t const* next)
+{
+    if (next->samples == 0U) {
+        return;
+    }
+
+    if (run->samples == 0U || next->shunt_min < run->shunt_min) {
+        run->shunt_min = next->shunt_min;
+    }
+    if (run->samples == 0U || next->shunt_max > run->shunt_max) {
+        run->shunt_max = next->shunt_max;
+    }
+    run->shunt_us += next->shunt_us;
+    segmenter_add_energy(run, next->energy - next->energy_error);
+    run->samples += next->samples;
+}
+
+// the hysteresis is taken from the state the reading would move away from: the candidate
+// while one is pending, the segment's state otherwise
+static size_t segmenter_classify(segmenter_t const* segmenter, int16_t shunt)
+{
+    segmenter_config_t const* config = &segmenter->config;
+    size_t state = segmenter->pending.samples > 0U ? segmenter->pending_state : segmenter->state;
+
+    while (state + 1U < config->state_count &&
+           (int32_t)shunt >= (int32_t)config->thresholds[state] + (int32_t)config->hysteresis[state]) {
+        ++state;
+    }
+    while (state > 0U &&
+           (int32_t)shunt < (int32_t)config->thresholds[state - 1U] - (int32_t)config->hysteresis[state - 1U]) {
+        --state;
+    }
+
+    return state;
+}
+
+static void segmenter_close(segmenter_t* segmenter, uint64_t end_us)
+{
+    segmenter_run_t const* run = &segmenter->current;
+
+    uint32_t const sequence = segmenter->closed++;
+    segmenter->residency_us[segmenter->state] += end_us - run->start_us;
+
+    if (segmenter->segment_count == SEGMENTER_MAX_SEGMENTS) {
+        ++segmenter->dropped;
+        return;
+    }
+
+    size_t const tail = (segmenter->segment_head + segmenter->segment_count) % SEGMENTER_MAX_SEGMENTS;
+    segmenter->segments[tail] = (segmenter_segment_t){.sequence = sequence,
+                                                      .state = (uint8_t)segmenter->state,
+                                                      .start_us = run->start_us,
+                                                      .duration_us = (uint32_t)(end_us - run->start_us),
+                                                      .samples = run->samples,
+                                                      .shunt_min = run->shunt_min,
+                                                      .shunt_max = run->shunt_max,
+                                                      .shunt_us = run->shunt_us,
+                                                      .energy = run->energy - run->energy_error};
+    ++segmenter->segment_count;
+}
+
+segmenter_err_t segmenter_initialize(segmenter_t* segmenter, segmenter_config_t const* config)
+{
+    assert(segmenter && config);
+
+    if (config->state_count < 2U || config->state_count > SEGMENTER_MAX_STATES || config->dwell_samples == 0U) {
+        return SEGMENTER_ERR_FAIL;
+    }
+    // the bands around neighbouring thresholds must not overlap, or a reading could move both ways
+    for (size_t i = 1U; i + 1U < config->state_count; ++i) {
+        if ((int32_t)config->thresholds[i] - (int32_t)config->hysteresis[i] <=
+            (int32_t)config->thresholds[i - 1U] + (int32_t)config->hysteresis[i - 1U]) {
+            return SEGMENTER_ERR_FAIL;
+        }
+    }
+
+    memset(segmenter, 0, sizeof(*segmenter));
+    memcpy(&segmenter->config, config, sizeof(*config));
+
+    return SEGMENTER_ERR_OK;
+}
+
+segmenter_err_t segmenter_deinitialize(segmenter_t* segmenter)
+{
+    assert(segmenter);
+
+    memset(segmenter, 0, sizeof(*segmenter));
+
+    return SEGMENTER_ERR_OK;
+}
+
+segmenter_err_t segmenter_push(segmenter_t* segmenter, int16_t shunt, float32_t power, uint64_t timestamp_us)
+{
+    assert(segmenter);
+
+    size_t const state = segmenter_classify(segmenter, shunt);
+    // a reading stands for the time since the previous one, the very first for none
+    uint32_t const dt_us = segmenter->is_started ? (uint32_t)(timestamp_us - segmenter->last_us) : 0U;
+    segmenter->last_us = timestamp_us;
+
+    if (!segmenter->is_started) {
+        segmenter->is_started = true;
+        segmenter->state = state;
+        segmenter_start_run(&segmenter->current, timestamp_us);
+    }
+
+    if (state == segmenter->state) {
+        // a candidate that did not hold was just noise within the current segment
+        segmenter_merge_run(&segmenter->current, &segmenter->pending);
+        segmenter->pending.samples = 0U;
+        segmenter_add_sample(&segmenter->current, shunt, power, dt_us);
+        return SEGMENTER_ERR_OK;
+    }
+
+    if (segmenter->pending.samples == 0U || state != segmenter->pending_state) {
+        segmenter_merge_run(&segmenter->current, &segmenter->pending);
+        segmenter_start_run(&segmenter->pending, timestamp_us);
+        segmenter->pending_state = state;
+    }
+    segmenter_add_sample(&segmenter->pending, shunt, power, dt_us);
+
+    if (segmenter->pending.samples >= segmenter->config.dwell_samples) {
+        segmenter_close(segmenter, segmenter->pending.start_us);
+        segmenter->state = segmenter->pending_state;
+        segmenter->current = segmenter->pending;
+        segmenter->pending.samples = 0U;
+    }
+
+    return SEGMENTER_ERR_OK;
+}
+
+segmenter_err_t segmenter_peek(segmenter_t const* segmenter, segmenter_segment_t* segment)
+{
+    assert(segmenter && segment);
+
+    if (segmenter->segment_count == 0U) {
+        return SEGMENTER_ERR_EMPTY;
+    }
+
+    *segment = segmenter->segments[segmenter->segment_head];
+
+    return SEGMENTER_ERR_OK;
+}
+
+segmenter_err_t segmenter_pop(segmenter_t* segmenter)
+{
+    assert(segmenter);
+
+    if (segmenter->segment_count == 0U) {
+        return SEGMENTER_ERR_EMPTY;
+    }
+
+    segmenter->segment_head = (segmenter->segment_head + 1U) % SEGMENTER_MAX_SEGMENTS;
+    --segmenter->segment_count;
+
+    return SEGMENTER_ERR_OK;
+}
@@ -0,0 +1,52 @@
+#ifndef SEGMENTER_SEGMENTER_H
+#define SEGMENTER_SEGMENTER_H
+
+#include "segmenter_config.h"
+
+// the integrals of a run of samples, each sample weighted by the time since the previous one;
+// the energy carries its rounding error along, so a segment of a day of samples keeps the
+// precision of a float32
+typedef struct {
+    uint64_t start_us;
+    uint32_t samples;
+    int16_t shunt_min;
+    int16_t shunt_max;
+    int64_t shunt_us;
+    float32_t energy;
+    float32_t energy_error;
+} segmenter_run_t;
+
+typedef struct {
+    segmenter_config_t config;
+
+    bool is_started;
+    uint64_t last_us;
+    size_t state;
+    segmenter_run_t current;
+
+    // a different state seen for fewer than dwell_samples so far
+    size_t pending_state;
+    segmenter_run_t pending;
+
+    segmenter_segment_t segments[SEGMENTER_MAX_SEGMENTS];
+    size_t segment_head;
+    size_t segment_count;
+
+    uint32_t closed;
+    uint32_t dropped;
+    // time per state over the closed segments
+    uint64_t residency_us[SEGMENTER_MAX_STATES];
+} segmenter_t;
+
+segmenter_err_t segmenter_initialize(segmenter_t* segmenter, segmenter_config_t const* config);
+segmenter_err_t segmenter_deinitialize(segmenter_t* segmenter);
+
+// feeds one raw shunt reading with the power of the same sample; the sample rate may vary, the
+// timestamps decide how much each reading counts
+segmenter_err_t segmenter_push(segmenter_t* segmenter, int16_t shunt, float32_t power, uint64_t timestamp_us);
+
+// the oldest closed segment stays queued until popped
+segmenter_err_t segmenter_peek(segmenter_t const* segmenter, segmenter_segment_t* segment);
+segmenter_err_t segmenter_pop(segmenter_t* segmenter);
+
+#endif // SEGMENTER_SEGMENTER_H
@@ -0,0 +1,46 @@
+#ifndef SEGMENTER_SEGMENTER_CONFIG_H
+#define SEGMENTER_SEGMENTER_CONFIG_H
+
+#include "ina226_config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SEGMENTER_MAX_STATES 6U
+// closed segments waiting to be read; a full queue drops new ones and counts them
+#define SEGMENTER_MAX_SEGMENTS 16U
+
+typedef enum {
+    SEGMENTER_ERR_OK = 0,
+    SEGMENTER_ERR_FAIL = 1 << 0,
+    SEGMENTER_ERR_NULL = 1 << 1,
+    SEGMENTER_ERR_EMPTY = 1 << 2,
+} segmenter_err_t;
+
+typedef struct {
+    size_t state_count;
+    // ascending raw shunt readings between state n and n + 1; crossing one upwards takes
+    // threshold + hysteresis, downwards threshold - hysteresis
+    int16_t thresholds[SEGMENTER_MAX_STATES - 1U];
+    uint16_t hysteresis[SEGMENTER_MAX_STATES - 1U];
+    // a new state has to hold this many samples in a row; they are counted to it afterwards
+    uint32_t dwell_samples;
+} segmenter_config_t;
+
+typedef struct {
+    // counts every closed segment, a gap means dropped ones
+    uint32_t sequence;
+    uint8_t state;
+    uint64_t start_us;
+    // up to the start of the next segment
+    uint32_t duration_us;
+    uint32_t samples;
+    int16_t shunt_min;
+    int16_t shunt_max;
+    // raw shunt LSB times microseconds, the charge once scaled
+    int64_t shunt_us;
+    // joules
+    float32_t energy;
+} segmenter_segment_t;
+
+#endif // SEGMENTER_SEGMENTER_CONFIG_H
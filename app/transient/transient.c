@@ -0,0 +1,184 @@
+#include "transient.h"
+#include <assert.h>
+#include <string.h>
+
+static void transient_queue(transient_t* transient, transient_record_t const* record)
+{
+    if (transient->record_count == TRANSIENT_MAX_RECORDS) {
+        ++transient->dropped;
+        return;
+    }
+
+    size_t const tail = (transient->record_head + transient->record_count) % TRANSIENT_MAX_RECORDS;
+    transient->records[tail] = *record;
+    ++transient->record_count;
+}
+
+static void transient_start_summary(transient_t* transient)
+{
+    memset(&transient->summary, 0, sizeof(transient->summary));
+}
+
+static void transient_start_event(transient_t* transient, int16_t baseline, uint64_t timestamp_us)
+{
+    transient->is_in_event = true;
+    transient->quiet_run = 0U;
+    transient->last_active_us = timestamp_us;
+    transient->event = (transient_event_t){.start_us = timestamp_us, .baseline = baseline};
+
+    ++transient->events;
+    ++transient->summary.events;
+}
+
+static void transient_end_event(transient_t* transient)
+{
+    transient_record_t record = {.kind = TRANSIENT_RECORD_EVENT, .event = transient->event};
+
+    // the quiet tail that ended it is left out of the duration, not out of the area
+    record.event.samples -= transient->quiet_run;
+    record.event.duration_us = (uint32_t)(transient->last_active_us - transient->event.start_us);
+
+    transient_queue(transient, &record);
+    transient->is_in_event = false;
+}
+
+static uint32_t transient_magnitude(int32_t value)
+{
+    return value < 0 ? (uint32_t)-value : (uint32_t)value;
+}
+
+transient_err_t transient_initialize(transient_t* transient, transient_config_t const* config)
+{
+    assert(transient && config);
+
+    if (config->threshold == 0U || config->release > config->threshold || config->hold_samples == 0U ||
+        config->max_samples <= config->hold_samples || config->baseline_shift > TRANSIENT_MAX_BASELINE_SHIFT) {
+        return TRANSIENT_ERR_FAIL;
+    }
+
+    memset(transient, 0, sizeof(*transient));
+    memcpy(&transient->config, config, sizeof(*config));
+
+    return TRANSIENT_ERR_OK;
+}
+
+transient_err_t transient_deinitialize(transient_t* transient)
+{
+    assert(transient);
+
+    memset(transient, 0, sizeof(*transient));
+
+    return TRANSIENT_ERR_OK;
+}
+
+transient_err_t transient_push(transient_t* transient, int16_t sample, uint64_t timestamp_us)
+{
+    assert(transient);
+
+    transient_config_t const* config = &transient->config;
+
+    if (!transient->has_baseline) {
+        transient->has_baseline = true;
+        transient->baseline_acc = (int32_t)sample * (1 << config->baseline_shift);
+        transient->previous = sample;
+        transient->previous_us = timestamp_us;
+    }
+
+    int16_t const baseline = transient_get_baseline(transient);
+    int32_t const excursion = (int32_t)sample - baseline;
+    uint32_t const magnitude = transient_magnitude(excursion);
+    uint32_t const step = transient_magnitude((int32_t)sample - transient->previous);
+    uint32_t const dt_us = (uint32_t)(timestamp_us - transient->previous_us);
+    transient->previous = sample;
+    transient->previous_us = timestamp_us;
+
+    if (!transient->is_in_event &&
+        (magnitude >= config->threshold || (config->slope > 0U && step >= config->slope))) {
+        transient_start_event(transient, baseline, timestamp_us);
+    }
+
+    if (transient->is_in_event) {
+        transient_event_t* event = &transient->event;
+
+        if (event->samples == 0U || magnitude > transient_magnitude((int32_t)event->peak - event->baseline)) {
+            event->peak = sample;
+            event->peak_offset = event->samples;
+        }
+        event->area += (int64_t)excursion * dt_us;
+        ++event->samples;
+
+        if (magnitude < config->release) {
+            ++transient->quiet_run;
+        } else {
+            transient->quiet_run = 0U;
+            transient->last_active_us = timestamp_us;
+        }
+
+        if (transient->quiet_run >= config->hold_samples) {
+            transient_end_event(transient);
+        } else if (event->samples == config->max_samples) {
+            // the rest goes out as a new event against the same baseline
+            transient_end_event(transient);
+            transient_start_event(transient, baseline, timestamp_us);
+        }
+    } else {
+        transient->baseline_acc += excursion;
+
+        transient_summary_t* summary = &transient->summary;
+        if (summary->quiet_samples == 0U || sample < summary->min) {
+            summary->min = sample;
+        }
+        if (summary->quiet_samples == 0U || sample > summary->max) {
+            summary->max = sample;
+        }
+        summary->sum += sample;
+        ++summary->quiet_samples;
+    }
+
+    if (config->summary_samples > 0U && ++transient->summary.samples == config->summary_samples) {
+        transient_record_t record = {.kind = TRANSIENT_RECORD_SUMMARY, .summary = transient->summary};
+        record.summary.end_us = timestamp_us;
+        record.summary.baseline = transient_get_baseline(transient);
+        transient_queue(transient, &record);
+        transient_start_summary(transient);
+    }
+
+    return TRANSIENT_ERR_OK;
+}
+
+transient_err_t transient_peek(transient_t const* transient, transient_record_t* record)
+{
+    assert(transient && record);
+
+    if (transient->record_count == 0U) {
+        return TRANSIENT_ERR_EMPTY;
+    }
+
+    *record = transient->records[transient->record_head];
+
+    return TRANSIENT_ERR_OK;
+}
+
+transient_err_t transient_pop(transient_t* transient)
+{
+    assert(transient);
+
+    if (transient->record_count == 0U) {
+        return TRANSIENT_ERR_EMPTY;
+    }
+
+    transient->record_head = (transient->record_head + 1U) % TRANSIENT_MAX_RECORDS;
+    --transient->record_count;
+
+    return TRANSIENT_ERR_OK;
+}
+
+int16_t transient_get_baseline(transient_t const* transient)
+{
+    assert(transient);
+
+    // rounded, so a steady input settles on itself rather than one LSB below
+    int32_t const half = transient->config.baseline_shift > 0U ? 1 << (transient->config.baseline_shift - 1U) : 0;
+
+    return (int16_t)((transient->baseline_acc + half) >> transient->config.baseline_shift);
+}
@@ -0,0 +1,41 @@
+#ifndef TRANSIENT_TRANSIENT_H
+#define TRANSIENT_TRANSIENT_H
+
+#include "transient_config.h"
+
+typedef struct {
+    transient_config_t config;
+
+    bool has_baseline;
+    int32_t baseline_acc;
+    int16_t previous;
+    uint64_t previous_us;
+
+    bool is_in_event;
+    uint32_t quiet_run;
+    uint64_t last_active_us;
+    transient_event_t event;
+
+    transient_summary_t summary;
+
+    transient_record_t records[TRANSIENT_MAX_RECORDS];
+    size_t record_head;
+    size_t record_count;
+
+    uint32_t events;
+    uint32_t dropped;
+} transient_t;
+
+transient_err_t transient_initialize(transient_t* transient, transient_config_t const* config);
+transient_err_t transient_deinitialize(transient_t* transient);
+
+// feeds one raw sample; the first one seeds the baseline and carries no area
+transient_err_t transient_push(transient_t* transient, int16_t sample, uint64_t timestamp_us);
+
+// the oldest record stays queued until popped, so a caller that cannot send it yet keeps it
+transient_err_t transient_peek(transient_t const* transient, transient_record_t* record);
+transient_err_t transient_pop(transient_t* transient);
+
+int16_t transient_get_baseline(transient_t const* transient);
+
+#endif // TRANSIENT_TRANSIENT_H
@@ -0,0 +1,76 @@
+#ifndef TRANSIENT_TRANSIENT_CONFIG_H
+#define TRANSIENT_TRANSIENT_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// records waiting to be read; a full queue drops new ones and counts them
+#define TRANSIENT_MAX_RECORDS 8U
+// the baseline is a running average with weight 2^-shift, kept in an int32
+#define TRANSIENT_MAX_BASELINE_SHIFT 15U
+
+typedef enum {
+    TRANSIENT_ERR_OK = 0,
+    TRANSIENT_ERR_FAIL = 1 << 0,
+    TRANSIENT_ERR_NULL = 1 << 1,
+    TRANSIENT_ERR_EMPTY = 1 << 2,
+} transient_err_t;
+
+typedef enum {
+    TRANSIENT_RECORD_EVENT,
+    TRANSIENT_RECORD_SUMMARY,
+} transient_record_kind_t;
+
+typedef struct {
+    // an event starts at this excursion from the baseline, or at a sample-to-sample step of
+    // at least slope (0 turns the step trigger off), both in raw LSBs
+    uint16_t threshold;
+    uint16_t slope;
+    // and ends once hold_samples in a row stay below release
+    uint16_t release;
+    uint32_t hold_samples;
+    // longer events go out in pieces of this many samples
+    uint32_t max_samples;
+    // the baseline only follows samples outside of events
+    uint32_t baseline_shift;
+    // a summary every this many samples, 0 for none
+    uint32_t summary_samples;
+} transient_config_t;
+
+typedef struct {
+    uint64_t start_us;
+    // from the first to the last sample at or above release
+    uint32_t duration_us;
+    uint32_t samples;
+    // the sample furthest from the baseline, and where it was
+    int16_t peak;
+    uint32_t peak_offset;
+    int16_t baseline;
+    // sample - baseline over the event, each sample weighted by the time since the previous
+    // one, in LSB microseconds; the charge once scaled
+    int64_t area;
+} transient_event_t;
+
+typedef struct {
+    uint64_t end_us;
+    uint32_t samples;
+    // min, max and sum over the samples outside of events
+    uint32_t quiet_samples;
+    int16_t min;
+    int16_t max;
+    int64_t sum;
+    int16_t baseline;
+    // events that started in the period
+    uint32_t events;
+} transient_summary_t;
+
+typedef struct {
+    transient_record_kind_t kind;
+    union {
+        transient_event_t event;
+        transient_summary_t summary;
+    };
+} transient_record_t;
+
+#endif // TRANSIENT_TRANSIENT_CONFIG_H
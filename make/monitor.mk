@@ -4,6 +4,10 @@ include make/common.mk
 monitor_uart:
 	minicom -D $(UART_PORT) -b 115200
 
+.PHONY: monitor_log
+monitor_log:
+	stty -F $(UART_PORT) 115200 raw -echo && python3 $(PROJECT_DIR)/tools/logger_decode.py $(PROJECT_BINARY) $(UART_PORT)
+
 .PHONY: monitor_usb
 monitor_usb:
 	minicom -D $(USB_PORT) -b 115200
\ No newline at end of file
@@ -95,6 +95,54 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Copy the SRAM2 data segment initializers from flash to SRAM2 */
+  ldr r0, =_ssram2_data
+  ldr r1, =_esram2_data
+  ldr r2, =_sisram2_data
+  movs r3, #0
+  b LoopCopySram2DataInit
+
+CopySram2DataInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopySram2DataInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopySram2DataInit
+
+/* Copy the code executed from SRAM2 out of flash */
+  ldr r0, =_sramfunc
+  ldr r1, =_eramfunc
+  ldr r2, =_siramfunc
+  movs r3, #0
+  b LoopCopyRamfuncInit
+
+CopyRamfuncInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyRamfuncInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyRamfuncInit
+
+/* Zero fill the SRAM2 bss segment. */
+  ldr r2, =_ssram2_bss
+  ldr r4, =_esram2_bss
+  movs r3, #0
+  b LoopFillZeroSram2bss
+
+FillZeroSram2bss:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopFillZeroSram2bss:
+  cmp r2, r4
+  bcc FillZeroSram2bss
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/
@@ -0,0 +1,24 @@
+/*
+ * Host stand-in for the two ACLE intrinsics app/filter uses, so its dual-MAC path can run in
+ * tools/filter_reference_test.c; not for target builds, which get the compiler's own header.
+ */
+
+#ifndef TOOLS_ACLE_HOST_ARM_ACLE_H
+#define TOOLS_ACLE_HOST_ARM_ACLE_H
+
+#include <stdint.h>
+
+typedef int32_t int16x2_t;
+
+// SMLALD: both halfword products added to a 64-bit accumulator
+static inline int64_t __smlald(int16x2_t a, int16x2_t b, int64_t accumulator)
+{
+    int16_t const a_low = (int16_t)(uint16_t)((uint32_t)a & 0xFFFFU);
+    int16_t const a_high = (int16_t)(uint16_t)((uint32_t)a >> 16U);
+    int16_t const b_low = (int16_t)(uint16_t)((uint32_t)b & 0xFFFFU);
+    int16_t const b_high = (int16_t)(uint16_t)((uint32_t)b >> 16U);
+
+    return accumulator + (int32_t)a_low * b_low + (int32_t)a_high * b_high;
+}
+
+#endif // TOOLS_ACLE_HOST_ARM_ACLE_H
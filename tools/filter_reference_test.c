@@ -0,0 +1,239 @@
+/*
+ * Host reference test of the Q15 FIR and Q2.14 biquad cascade in app/filter/filter.c.
+ *
+ * Runs both filters over a full-scale pseudo-random stream and compares every output and the
+ * saturation counts against a straightforward double-precision model of the same arithmetic
+ * (round half up, saturate to int16, saturated section outputs as biquad state). The FIR is
+ * checked for 1 to FILTER_FIR_MAX_TAPS taps, fed in odd piece sizes and in place.
+ *
+ * usage: cc -std=c2x -O2 -Iapp/filter tools/filter_reference_test.c app/filter/filter.c \
+ *            -lm -o filter_reference_test && ./filter_reference_test
+ *        add -D__ARM_FEATURE_SIMD32=1 -Itools/acle_host to run the SMLALD dual-MAC path through
+ *        the emulated intrinsic instead of the plain C loop
+ */
+
+#include "filter.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_SAMPLES 1024U
+#define TEST_RUNS_PER_TAPS 4U
+
+// piece sizes the stream is fed in, around and across FILTER_FIR_CHUNK_SIZE
+static size_t const test_pieces[] = {1U, 3U, 7U, 31U, 32U, 33U, 50U, 97U};
+
+static filter_biquad_section_t const test_sections[] = {
+    // the shunt notch from app/main
+    {.b0 = 15893, .b1 = -30230, .b2 = 15893, .a1 = -30230, .a2 = 15402},
+    // low-pass with gain above one, saturates on a full-scale input
+    {.b0 = 6000, .b1 = 12000, .b2 = 6000, .a1 = -16000, .a2 = 6000},
+    // resonant, long ringing
+    {.b0 = 4096, .b1 = 0, .b2 = -4096, .a1 = -31000, .a2 = 15800},
+    // plain gain of -1.5
+    {.b0 = -24576, .b1 = 0, .b2 = 0, .a1 = 0, .a2 = 0},
+};
+
+static int16_t test_input[TEST_SAMPLES];
+static int16_t test_output[TEST_SAMPLES];
+static int16_t test_reference[TEST_SAMPLES];
+
+static int16_t reference_saturate(double value, uint32_t* saturations)
+{
+    if (value > INT16_MAX) {
+        ++*saturations;
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        ++*saturations;
+        return INT16_MIN;
+    }
+
+    return (int16_t)value;
+}
+
+static double reference_round(double accumulator, unsigned shift)
+{
+    return floor(accumulator / (double)(1U << shift) + 0.5);
+}
+
+static void reference_fir(filter_fir_config_t const* config,
+                          int16_t const* input,
+                          int16_t* output,
+                          size_t count,
+                          uint32_t* saturations)
+{
+    for (size_t n = 0U; n < count; ++n) {
+        double accumulator = 0.0;
+        for (size_t k = 0U; k < config->taps && k <= n; ++k) {
+            accumulator += (double)config->coefficients[k] * (double)input[n - k];
+        }
+        output[n] = reference_saturate(reference_round(accumulator, FILTER_FIR_COEFFICIENT_SHIFT), saturations);
+    }
+}
+
+static void reference_biquad(filter_biquad_config_t const* config,
+                             int16_t const* input,
+                             int16_t* output,
+                             size_t count,
+                             uint32_t* saturations)
+{
+    memmove(output, input, count * sizeof(*input));
+
+    for (size_t i = 0U; i < config->section_count; ++i) {
+        filter_biquad_section_t const* section = &config->sections[i];
+        double x1 = 0.0;
+        double x2 = 0.0;
+        double y1 = 0.0;
+        double y2 = 0.0;
+
+        for (size_t n = 0U; n < count; ++n) {
+            double const x0 = output[n];
+            double const accumulator = section->b0 * x0 + section->b1 * x1 + section->b2 * x2 -
+                                       section->a1 * y1 - section->a2 * y2;
+            output[n] = reference_saturate(reference_round(accumulator, FILTER_BIQUAD_COEFFICIENT_SHIFT), saturations);
+
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = output[n];
+        }
+    }
+}
+
+static int compare(char const* name, size_t variant, uint32_t saturations, uint32_t expected_saturations)
+{
+    for (size_t n = 0U; n < TEST_SAMPLES; ++n) {
+        if (test_output[n] != test_reference[n]) {
+            printf("%s %zu: sample %zu is %d, expected %d\n",
+                   name,
+                   variant,
+                   n,
+                   test_output[n],
+                   test_reference[n]);
+            return 1;
+        }
+    }
+    if (saturations != expected_saturations) {
+        printf("%s %zu: %u saturations, expected %u\n", name, variant, saturations, expected_saturations);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_fir(size_t taps, size_t run)
+{
+    filter_fir_config_t config = {.taps = taps};
+    // loud enough on the later runs for the sum to leave int16
+    int const range = (int)(32768U * (run + 1U) / (taps * 2U)) + 1;
+    for (size_t k = 0U; k < taps; ++k) {
+        config.coefficients[k] = (int16_t)(rand() % (2 * range + 1) - range);
+    }
+
+    uint32_t expected_saturations = 0U;
+    reference_fir(&config, test_input, test_reference, TEST_SAMPLES, &expected_saturations);
+
+    filter_fir_t fir;
+    if (filter_fir_initialize(&fir, &config) != FILTER_ERR_OK) {
+        printf("fir %zu: initialize failed\n", taps);
+        return 1;
+    }
+
+    int failures = 0;
+
+    // separate buffers, fed in uneven pieces
+    size_t offset = 0U;
+    for (size_t i = run; offset < TEST_SAMPLES; ++i) {
+        size_t piece = test_pieces[i % (sizeof(test_pieces) / sizeof(test_pieces[0]))];
+        if (piece > TEST_SAMPLES - offset) {
+            piece = TEST_SAMPLES - offset;
+        }
+        filter_fir_process(&fir, &test_input[offset], &test_output[offset], piece);
+        offset += piece;
+    }
+    failures += compare("fir", taps, fir.saturations, expected_saturations);
+
+    // in place, all at once
+    filter_fir_reset(&fir);
+    fir.saturations = 0U;
+    memcpy(test_output, test_input, sizeof(test_output));
+    filter_fir_process(&fir, test_output, test_output, TEST_SAMPLES);
+    failures += compare("fir in place", taps, fir.saturations, expected_saturations);
+
+    filter_fir_deinitialize(&fir);
+
+    return failures;
+}
+
+static int test_biquad(size_t first, size_t section_count)
+{
+    filter_biquad_config_t config = {.section_count = section_count};
+    size_t const available = sizeof(test_sections) / sizeof(test_sections[0]);
+    for (size_t i = 0U; i < section_count; ++i) {
+        config.sections[i] = test_sections[(first + i) % available];
+    }
+
+    uint32_t expected_saturations = 0U;
+    reference_biquad(&config, test_input, test_reference, TEST_SAMPLES, &expected_saturations);
+
+    filter_biquad_t biquad;
+    if (filter_biquad_initialize(&biquad, &config) != FILTER_ERR_OK) {
+        printf("biquad %zu: initialize failed\n", section_count);
+        return 1;
+    }
+
+    int failures = 0;
+
+    // the state has to carry across blocks for the split run to match
+    size_t offset = 0U;
+    for (size_t i = first; offset < TEST_SAMPLES; ++i) {
+        size_t piece = test_pieces[i % (sizeof(test_pieces) / sizeof(test_pieces[0]))];
+        if (piece > TEST_SAMPLES - offset) {
+            piece = TEST_SAMPLES - offset;
+        }
+        filter_biquad_process(&biquad, &test_input[offset], &test_output[offset], piece);
+        offset += piece;
+    }
+    failures += compare("biquad", first * 10U + section_count, biquad.saturations, expected_saturations);
+
+    filter_biquad_reset(&biquad);
+    biquad.saturations = 0U;
+    memcpy(test_output, test_input, sizeof(test_output));
+    filter_biquad_process(&biquad, test_output, test_output, TEST_SAMPLES);
+    failures += compare("biquad in place", first * 10U + section_count, biquad.saturations, expected_saturations);
+
+    filter_biquad_deinitialize(&biquad);
+
+    return failures;
+}
+
+int main(void)
+{
+    srand(1U);
+    for (size_t n = 0U; n < TEST_SAMPLES; ++n) {
+        test_input[n] = (int16_t)(rand() % 65536 - 32768);
+    }
+    test_input[0] = INT16_MAX;
+    test_input[1] = INT16_MIN;
+    test_input[2] = INT16_MIN;
+
+    int failures = 0;
+
+    for (size_t taps = 1U; taps <= FILTER_FIR_MAX_TAPS; ++taps) {
+        for (size_t run = 0U; run < TEST_RUNS_PER_TAPS; ++run) {
+            failures += test_fir(taps, run);
+        }
+    }
+
+    for (size_t first = 0U; first < sizeof(test_sections) / sizeof(test_sections[0]); ++first) {
+        for (size_t section_count = 0U; section_count <= FILTER_BIQUAD_MAX_SECTIONS; ++section_count) {
+            failures += test_biquad(first, section_count);
+        }
+    }
+
+    printf("%s, %d failures\n", failures == 0 ? "ok" : "FAILED", failures);
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+"""Merges histogram snapshots written by ina226_client.py --histogram and prints the tails.
+
+Snapshots from several boards or several dumps of one run add up bucket by bucket, as long as
+they share the bucket layout; quantiles come out as the highest reading of their bucket, the
+same way the firmware reports them in its telemetry.
+
+usage: histogram_merge.py board1.json board2.json
+       histogram_merge.py --output all.json --quantiles 0.5,0.9,0.99,0.999 day*.json
+"""
+
+import argparse
+import json
+import sys
+
+from ina226_client import SHUNT_LSB_V, Histogram
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("snapshots", nargs="+", help="JSON snapshots to merge")
+    parser.add_argument("--output", metavar="JSON", help="write the merged histogram here")
+    parser.add_argument("--quantiles", default="0.5,0.99,0.999", help="comma separated (default: 0.5,0.99,0.999)")
+    parser.add_argument("--shunt", type=float, metavar="OHM", help="also print the quantiles as current")
+    args = parser.parse_args()
+
+    merged = None
+    for path in args.snapshots:
+        with open(path) as source:
+            histogram = Histogram.from_json(json.load(source))
+        try:
+            merged = histogram if merged is None else merged.merge(histogram)
+        except ValueError as error:
+            sys.exit(f"{path}: {error}")
+
+    print(merged)
+    for quantile in (float(text) for text in args.quantiles.split(",")):
+        raw = merged.quantile(quantile) if merged.total else 0
+        line = f"p{quantile * 100:g}: {raw} LSB, {raw * SHUNT_LSB_V * 1e3:.4f}mV"
+        if args.shunt:
+            line += f", {raw * SHUNT_LSB_V / args.shunt * 1e3:.3f}mA"
+        print(line)
+
+    if args.output:
+        with open(args.output, "w") as out:
+            json.dump(merged.to_json(), out, indent=1)
+
+
+if __name__ == "__main__":
+    main()
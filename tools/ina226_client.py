@@ -0,0 +1,713 @@
+#!/usr/bin/env python3
+"""Sends batched configuration requests to the firmware over the UART and waits for the answer.
+
+A request is one COBS frame terminated by a zero byte: u8 sequence, u8 op count, then per op
+u8 device, u8 op and a u16 little-endian value. The firmware checks every op before touching
+anything, applies the batch between two samples, merging all CONFIG fields of a device into one
+write, and answers with a raw log record (id 0xFF00) holding a header word
+(sequence | status << 8 | count << 16) and per op (result | status << 16 | op << 24).
+
+usage: ina226_client.py /dev/ttyUSB0 averaging=0:3 bus_ct=0:4 shunt_ct=0:4
+       ina226_client.py /dev/ttyUSB0 read=0:0x05 read=0:0xFE
+       ina226_client.py /dev/ttyUSB0 profile=1
+       ina226_client.py /dev/ttyUSB0 bandwidth=200
+       ina226_client.py /dev/ttyUSB0 decimation=1024
+       ina226_client.py /dev/ttyUSB0 telemetry reset
+       ina226_client.py /dev/ttyUSB0 capture=2000 --capture window.csv
+       ina226_client.py /dev/ttyUSB0 alert=current_over:0.5:latch
+       ina226_client.py /dev/ttyUSB0 alert=current_over:0.5 hysteresis=0.4
+       ina226_client.py /dev/ttyUSB0 transient=400 --transients 60
+       ina226_client.py /dev/ttyUSB0 segments=40,800,4000 --segments 3600
+       ina226_client.py /dev/ttyUSB0 histogram=1 --histogram board1.json
+       ina226_client.py /dev/ttyUSB0 trigger=1
+
+Ops are written op=device:value; telemetry and reset take no arguments, profile only the index
+(0 default, 1 high bandwidth, 2 low noise) and writes just the registers that differ, and
+bandwidth the signal bandwidth in Hz the adaptive averaging has to keep (0 turns it off, which
+leaves averaging and conversion times to the other ops); decimation is the number of shunt
+results, a power of two up to 4096, summed into each logged high-resolution reading. capture
+arms the scope mode on channel 0 with a software trigger at that many shunt LSBs (2.5 uV each,
+0 leaves only the ALERT pin, set up with the mask and alert_limit ops), disarm stops it; with
+--capture the client then waits for a window and writes it as CSV. alert programs the ALERT
+pin as function:limit[:latch], the limit in volts, watts or amperes, converted on the device
+(off, shunt_over, shunt_under, bus_over, bus_under, power_over, current_over, current_under);
+it takes three ops of the batch. hysteresis gives the non-latched alert a release limit in the
+same units, on the inactive side of the trigger limit, which the device switches to while the pin
+is asserted (off goes back to the single limit); it also takes three ops. transient switches the
+shunt stream to event mode with that many shunt LSBs of excursion or step as the trigger (0 goes
+back to the decimated readings); with --transients the client then prints the event records and
+the once-a-second baseline summaries for that many seconds. segments splits channel 0 into power
+states at the given ascending shunt LSB thresholds (default for sleep, idle, active and transmit
+at 1, 20 and 100 mA, off to stop); with --segments the client prints every closed segment with its
+charge and energy for that many seconds. histogram dumps a snapshot of the channel 0 shunt reading
+histogram (1 also starts it over); with --histogram the client writes it as JSON, which
+histogram_merge.py combines across boards and runs. trigger=1 switches the acquisition to
+synchronized batches, every device triggered back to back and read in ready-time order with one
+timestamp per batch and the CONFIG write skew in the telemetry, trigger=0 goes back to continuous
+conversions. Log records arriving in between are skipped, so this can run
+while nothing else reads the port.
+
+As a library:
+    with Client("/dev/ttyUSB0") as client:
+        response = client.send(Batch().averaging(0, 3).mode(0, 7))
+"""
+
+import argparse
+import json
+import os
+import select
+import struct
+import sys
+import termios
+import time
+
+OP_SET_AVERAGING = 0x01
+OP_SET_BUS_CONVERSION_TIME = 0x02
+OP_SET_SHUNT_CONVERSION_TIME = 0x03
+OP_SET_MODE = 0x04
+OP_SET_CALIBRATION = 0x05
+OP_SET_MASK_ENABLE = 0x06
+OP_SET_ALERT_LIMIT = 0x07
+OP_READ_REGISTER = 0x08
+OP_TELEMETRY = 0x40
+OP_RESET_COUNTERS = 0x41
+OP_SET_PROFILE = 0x42
+OP_SET_BANDWIDTH = 0x43
+OP_SET_DECIMATION = 0x44
+OP_ARM_CAPTURE = 0x45
+OP_DISARM_CAPTURE = 0x46
+OP_SET_ALERT_LIMIT_LOW = 0x47
+OP_SET_ALERT_LIMIT_HIGH = 0x48
+OP_SET_ALERT = 0x49
+OP_SET_ALERT_HYSTERESIS = 0x4A
+OP_SET_TRANSIENT = 0x4B
+OP_ADD_SEGMENT_THRESHOLD = 0x4C
+OP_SET_SEGMENTER = 0x4D
+OP_DUMP_HISTOGRAM = 0x4E
+OP_SET_ACQUISITION_MODE = 0x4F
+
+ALERT_FUNCTIONS = {
+    "off": 0,
+    "shunt_over": 1,
+    "shunt_under": 2,
+    "bus_over": 3,
+    "bus_under": 4,
+    "power_over": 5,
+    "current_over": 6,
+    "current_under": 7,
+}
+ALERT_LATCH_FLAG = 0x100
+
+STATUS_NAMES = {
+    0x00: "ok",
+    0x01: "bad frame",
+    0x02: "bad op",
+    0x03: "bad device",
+    0x04: "bad value",
+    0x05: "busy",
+    0x06: "bus fail",
+    0x07: "not applied",
+}
+
+OP_NAMES = {
+    "averaging": OP_SET_AVERAGING,
+    "bus_ct": OP_SET_BUS_CONVERSION_TIME,
+    "shunt_ct": OP_SET_SHUNT_CONVERSION_TIME,
+    "mode": OP_SET_MODE,
+    "calibration": OP_SET_CALIBRATION,
+    "mask": OP_SET_MASK_ENABLE,
+    "alert_limit": OP_SET_ALERT_LIMIT,
+    "read": OP_READ_REGISTER,
+    "telemetry": OP_TELEMETRY,
+    "reset": OP_RESET_COUNTERS,
+    "profile": OP_SET_PROFILE,
+    "bandwidth": OP_SET_BANDWIDTH,
+    "decimation": OP_SET_DECIMATION,
+    "capture": OP_ARM_CAPTURE,
+    "disarm": OP_DISARM_CAPTURE,
+    "alert": OP_SET_ALERT,
+    "hysteresis": OP_SET_ALERT_HYSTERESIS,
+    "transient": OP_SET_TRANSIENT,
+    "histogram": OP_DUMP_HISTOGRAM,
+    "trigger": OP_SET_ACQUISITION_MODE,
+}
+
+MAX_OPS = 8
+RESPONSE_ID = 0xFF00
+CAPTURE_ID = 0xFF01
+TRANSIENT_ID = 0xFF02
+SEGMENT_ID = 0xFF03
+HISTOGRAM_ID = 0xFF04
+
+CAPTURE_RECORD_HEADER = 0
+CAPTURE_RECORD_DATA = 1
+CAPTURE_SOURCE_NAMES = {0: "none", 1: "threshold", 2: "alert"}
+SHUNT_LSB_V = 2.5e-6
+
+HISTOGRAM_RECORD_HEADER = 0
+HISTOGRAM_RECORD_DATA = 1
+
+TRANSIENT_RECORD_EVENT = 0
+TRANSIENT_RECORD_SUMMARY = 1
+
+HEADER_COUNT_SHIFT = 16
+HEADER_COUNT_MASK = 0xF
+HEADER_ID_MASK = 0xFFFF
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for byte in data:
+        if byte == 0:
+            out += bytes([len(block) + 1]) + block
+            block.clear()
+            continue
+        block.append(byte)
+        if len(block) == 0xFE:
+            out += b"\xff" + block
+            block.clear()
+    out += bytes([len(block) + 1]) + block
+    return bytes(out)
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    index = 0
+    while index < len(frame):
+        code = frame[index]
+        if code == 0:
+            raise ValueError("zero byte inside a frame")
+        block = frame[index + 1:index + code]
+        if len(block) != code - 1:
+            raise ValueError("truncated frame")
+        out += block
+        index += code
+        if code != 0xFF and index < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+class Batch:
+    """Up to MAX_OPS ops that the firmware applies all together or not at all."""
+
+    def __init__(self):
+        self.ops = []
+
+    def add(self, op, device=0, value=0):
+        if len(self.ops) == MAX_OPS:
+            raise ValueError(f"at most {MAX_OPS} ops per batch")
+        self.ops.append((device, op, value & 0xFFFF))
+        return self
+
+    def averaging(self, device, avg):
+        return self.add(OP_SET_AVERAGING, device, avg)
+
+    def bus_conversion_time(self, device, ct):
+        return self.add(OP_SET_BUS_CONVERSION_TIME, device, ct)
+
+    def shunt_conversion_time(self, device, ct):
+        return self.add(OP_SET_SHUNT_CONVERSION_TIME, device, ct)
+
+    def mode(self, device, mode):
+        return self.add(OP_SET_MODE, device, mode)
+
+    def calibration(self, device, calibration):
+        return self.add(OP_SET_CALIBRATION, device, calibration)
+
+    def mask_enable(self, device, mask):
+        return self.add(OP_SET_MASK_ENABLE, device, mask)
+
+    def alert_limit(self, device, limit):
+        return self.add(OP_SET_ALERT_LIMIT, device, limit)
+
+    def read_register(self, device, address):
+        return self.add(OP_READ_REGISTER, device, address)
+
+    def telemetry(self):
+        return self.add(OP_TELEMETRY)
+
+    def reset_counters(self):
+        return self.add(OP_RESET_COUNTERS)
+
+    def profile(self, index):
+        return self.add(OP_SET_PROFILE, 0, index)
+
+    def bandwidth(self, hz):
+        return self.add(OP_SET_BANDWIDTH, 0, hz)
+
+    def decimation(self, ratio):
+        return self.add(OP_SET_DECIMATION, 0, ratio)
+
+    def arm_capture(self, threshold):
+        return self.add(OP_ARM_CAPTURE, 0, threshold)
+
+    def disarm_capture(self):
+        return self.add(OP_DISARM_CAPTURE)
+
+    def alert(self, function, limit=0.0, latched=False):
+        self._alert_limit(limit)
+        return self.add(OP_SET_ALERT, 0, ALERT_FUNCTIONS[function] | (ALERT_LATCH_FLAG if latched else 0))
+
+    def hysteresis(self, release=None):
+        if release is None:
+            return self.add(OP_SET_ALERT_HYSTERESIS, 0, 0)
+        self._alert_limit(release)
+        return self.add(OP_SET_ALERT_HYSTERESIS, 0, 1)
+
+    def triggered(self, enable=True):
+        """All devices triggered back to back per block and read in ready-time order."""
+        return self.add(OP_SET_ACQUISITION_MODE, 0, 1 if enable else 0)
+
+    def segments(self, thresholds=None):
+        """Power states split at ascending shunt LSB thresholds, the default states for None, [] to stop."""
+        if thresholds is None:
+            return self.add(OP_SET_SEGMENTER, 0, 1)
+        for threshold in thresholds:
+            self.add(OP_ADD_SEGMENT_THRESHOLD, 0, threshold)
+        return self.add(OP_SET_SEGMENTER, 0, len(thresholds) + 1 if thresholds else 0)
+
+    def _alert_limit(self, limit):
+        bits = struct.unpack("<I", struct.pack("<f", limit))[0]
+        self.add(OP_SET_ALERT_LIMIT_LOW, 0, bits & 0xFFFF)
+        self.add(OP_SET_ALERT_LIMIT_HIGH, 0, bits >> 16)
+
+    def encode(self, sequence):
+        if not self.ops:
+            raise ValueError("empty batch")
+        payload = bytes([sequence & 0xFF, len(self.ops)])
+        for device, op, value in self.ops:
+            payload += struct.pack("<BBH", device, op, value)
+        return cobs_encode(payload) + b"\0"
+
+
+class Response:
+    def __init__(self, words):
+        header = words[0]
+        self.sequence = header & 0xFF
+        self.status = (header >> 8) & 0xFF
+        self.results = []
+        for word in words[1:1 + ((header >> 16) & 0xFF)]:
+            self.results.append({"op": word >> 24, "status": (word >> 16) & 0xFF, "value": word & 0xFFFF})
+
+    @property
+    def is_ok(self):
+        return self.status == 0
+
+    def __str__(self):
+        lines = [f"seq {self.sequence}: {STATUS_NAMES.get(self.status, self.status)}"]
+        for result in self.results:
+            lines.append(f"  op 0x{result['op']:02x} {STATUS_NAMES.get(result['status'], result['status'])}"
+                         f" value=0x{result['value']:04x}")
+        return "\n".join(lines)
+
+
+class Capture:
+    """One frozen scope window, raw shunt readings with the trigger sample at index pre_count."""
+
+    def __init__(self, words):
+        self.sequence = words[0] & 0xFFFF
+        self.source = (words[0] >> 16) & 0xFF
+        self.pre_count = words[1] & 0xFFFF
+        self.count = words[1] >> 16
+        self.trigger_us = words[2] | (words[3] << 32)
+        self.samples = [None] * self.count
+
+    def add(self, words):
+        offset, count = words[1] & 0xFFFF, words[1] >> 16
+        for index in range(count):
+            raw = (words[2 + index // 2] >> (16 * (index % 2))) & 0xFFFF
+            if offset + index < self.count:
+                self.samples[offset + index] = raw - 0x10000 if raw & 0x8000 else raw
+
+    @property
+    def is_complete(self):
+        return None not in self.samples
+
+    def write_csv(self, out):
+        out.write("index,raw,shunt_v\n")
+        for index, raw in enumerate(self.samples):
+            out.write(f"{index - self.pre_count},{raw},{raw * SHUNT_LSB_V:.7f}\n")
+
+    def __str__(self):
+        return (f"capture {self.sequence}: {CAPTURE_SOURCE_NAMES.get(self.source, self.source)} trigger at"
+                f" {self.trigger_us}us, {self.pre_count} + {self.count - self.pre_count} samples")
+
+
+def _int16(raw):
+    return raw - 0x10000 if raw & 0x8000 else raw
+
+
+def _float32(word):
+    return struct.unpack("<f", struct.pack("<I", word))[0]
+
+
+class Transient:
+    """An event or baseline summary record of one channel in event mode."""
+
+    def __init__(self, words):
+        self.kind = words[0] >> 24
+        self.channel = (words[0] >> 16) & 0xFF
+        self.timestamp_us = words[1] | (words[2] << 32)
+        if self.kind == TRANSIENT_RECORD_EVENT:
+            self.duration_us = words[3]
+            self.samples = words[4]
+            self.peak = _int16(words[5] & 0xFFFF)
+            self.baseline = _int16(words[5] >> 16)
+            self.peak_offset = words[6]
+            # LSB microseconds, charge_nc is the same scaled
+            area = words[7] | (words[8] << 32)
+            self.area = area - (1 << 64) if area >> 63 else area
+            self.charge_nc = _float32(words[9])
+        else:
+            self.samples = words[3]
+            self.quiet_samples = words[4]
+            self.min = _int16(words[5] & 0xFFFF)
+            self.max = _int16(words[5] >> 16)
+            self.baseline = _int16(words[6] & 0xFFFF)
+            self.mean = _float32(words[7])
+            self.events = words[8]
+
+    def __str__(self):
+        if self.kind == TRANSIENT_RECORD_EVENT:
+            return (f"ch{self.channel} event at {self.timestamp_us}us for {self.duration_us}us ({self.samples} samples):"
+                    f" peak {self.peak * SHUNT_LSB_V * 1e3:.3f}mV after {self.peak_offset} samples,"
+                    f" baseline {self.baseline * SHUNT_LSB_V * 1e3:.3f}mV, {self.charge_nc:.1f}nC")
+        return (f"ch{self.channel} summary to {self.timestamp_us}us: {self.quiet_samples}/{self.samples} quiet,"
+                f" mean {self.mean * SHUNT_LSB_V * 1e3:.4f}mV [{self.min * SHUNT_LSB_V * 1e3:.3f}.."
+                f"{self.max * SHUNT_LSB_V * 1e3:.3f}]mV, baseline {self.baseline * SHUNT_LSB_V * 1e3:.3f}mV,"
+                f" {self.events} events")
+
+
+class Segment:
+    """One run of a single power state on channel 0."""
+
+    def __init__(self, words):
+        self.state = words[0] & 0xFF
+        self.sequence = words[0] >> 16
+        self.start_us = words[1] | (words[2] << 32)
+        self.duration_us = words[3]
+        self.samples = words[4]
+        self.min = _int16(words[5] & 0xFFFF)
+        self.max = _int16(words[5] >> 16)
+        self.charge_c = _float32(words[6])
+        self.energy_j = _float32(words[7])
+
+    def __str__(self):
+        mean_a = self.charge_c / (self.duration_us * 1e-6) if self.duration_us else 0.0
+        return (f"segment {self.sequence}: state {self.state} at {self.start_us}us for {self.duration_us}us"
+                f" ({self.samples} samples), mean {mean_a * 1e3:.3f}mA, {self.charge_c * 1e6:.1f}uC,"
+                f" {self.energy_j * 1e3:.3f}mJ")
+
+
+class Histogram:
+    """Log-linear histogram of raw shunt readings in the firmware's bucket layout."""
+
+    def __init__(self, sub_bucket_bits, total=0, minimum=0, maximum=0, total_sum=0, start_us=0, end_us=0,
+                 counts=None):
+        self.sub_bucket_bits = sub_bucket_bits
+        self.total = total
+        self.min = minimum
+        self.max = maximum
+        self.sum = total_sum
+        self.start_us = start_us
+        self.end_us = end_us
+        self.counts = dict(counts or {})
+        self.buckets = 0
+
+    @property
+    def magnitude_buckets(self):
+        return (16 - self.sub_bucket_bits + 1) << self.sub_bucket_bits
+
+    @classmethod
+    def from_header(cls, words):
+        total_sum = words[4] | (words[5] << 32)
+        histogram = cls((words[0] >> 16) & 0xFF, words[1] | (words[2] << 32), _int16(words[3] & 0xFFFF),
+                        _int16(words[3] >> 16), total_sum - (1 << 64) if total_sum >> 63 else total_sum,
+                        words[6] | (words[7] << 32), words[8] | (words[9] << 32))
+        histogram.sequence = words[0] & 0xFFFF
+        histogram.buckets = words[10]
+        return histogram
+
+    def add(self, words):
+        for index, count in zip(words[1::2], words[2::2]):
+            self.counts[index] = count
+
+    @property
+    def is_complete(self):
+        return len(self.counts) == self.buckets
+
+    def bucket_range(self, index):
+        """Lowest and highest reading of a bucket, both inclusive."""
+        sub_buckets = 1 << self.sub_bucket_bits
+        magnitude = index - self.magnitude_buckets if index >= self.magnitude_buckets else self.magnitude_buckets - index
+        if magnitude < sub_buckets:
+            lowest = highest = magnitude
+        else:
+            shift = magnitude // sub_buckets - 1
+            lowest = (sub_buckets + magnitude % sub_buckets) << shift
+            highest = lowest + (1 << shift) - 1
+        return (lowest, highest) if index >= self.magnitude_buckets else (-highest, -lowest)
+
+    def merge(self, other):
+        if other.sub_bucket_bits != self.sub_bucket_bits:
+            raise ValueError("histograms with different bucket layouts")
+        if other.total == 0:
+            return self
+        if self.total == 0:
+            self.min, self.max, self.start_us, self.end_us = other.min, other.max, other.start_us, other.end_us
+        else:
+            self.min, self.max = min(self.min, other.min), max(self.max, other.max)
+            self.start_us, self.end_us = min(self.start_us, other.start_us), max(self.end_us, other.end_us)
+        for index, count in other.counts.items():
+            self.counts[index] = self.counts.get(index, 0) + count
+        self.total += other.total
+        self.sum += other.sum
+        return self
+
+    def quantile(self, quantile):
+        """Highest reading of the bucket holding the quantile, clamped to min and max, like the firmware."""
+        rank = max(1, -(-self.total * round(quantile * 1e6) // 1000000))
+        seen = 0
+        for index in sorted(self.counts):
+            seen += self.counts[index]
+            if seen >= rank:
+                return min(max(self.bucket_range(index)[1], self.min), self.max)
+        return self.max
+
+    def to_json(self):
+        return {"sub_bucket_bits": self.sub_bucket_bits, "total": self.total, "min": self.min, "max": self.max,
+                "sum": self.sum, "start_us": self.start_us, "end_us": self.end_us,
+                "counts": {str(index): count for index, count in sorted(self.counts.items())}}
+
+    @classmethod
+    def from_json(cls, data):
+        return cls(data["sub_bucket_bits"], data["total"], data["min"], data["max"], data["sum"], data["start_us"],
+                   data["end_us"], {int(index): count for index, count in data["counts"].items()})
+
+    def __str__(self):
+        if self.total == 0:
+            return "histogram: empty"
+        mean = self.sum / self.total
+        return (f"histogram: {self.total} readings over {(self.end_us - self.start_us) / 1e6:.1f}s, mean"
+                f" {mean * SHUNT_LSB_V * 1e3:.4f}mV, p50 {self.quantile(0.5) * SHUNT_LSB_V * 1e3:.4f}mV,"
+                f" p99 {self.quantile(0.99) * SHUNT_LSB_V * 1e3:.4f}mV,"
+                f" p99.9 {self.quantile(0.999) * SHUNT_LSB_V * 1e3:.4f}mV, max {self.max * SHUNT_LSB_V * 1e3:.4f}mV")
+
+
+class Client:
+    def __init__(self, port, baudrate=termios.B115200, timeout=1.0):
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+        self.timeout = timeout
+        self.sequence = 0
+        self.buffer = bytearray()
+
+        # raw 8N1, no pyserial needed
+        attributes = termios.tcgetattr(self.fd)
+        attributes[0] = 0
+        attributes[1] = 0
+        attributes[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attributes[3] = 0
+        attributes[4] = baudrate
+        attributes[5] = baudrate
+        termios.tcsetattr(self.fd, termios.TCSANOW, attributes)
+
+    def close(self):
+        os.close(self.fd)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *_):
+        self.close()
+
+    def send(self, batch):
+        self.sequence = (self.sequence + 1) & 0xFF
+        # the leading delimiter ends whatever half frame the firmware might still hold
+        os.write(self.fd, b"\0" + batch.encode(self.sequence))
+        return self._wait_response(self.sequence)
+
+    def wait_capture(self, timeout):
+        """The next complete capture window; a window whose records got lost is skipped."""
+        deadline = time.monotonic() + timeout
+        capture = None
+        while True:
+            for words in self._records(CAPTURE_ID):
+                kind = words[0] >> 24
+                if kind == CAPTURE_RECORD_HEADER and len(words) >= 4:
+                    capture = Capture(words)
+                elif kind == CAPTURE_RECORD_DATA and capture and words[0] & 0xFFFF == capture.sequence:
+                    capture.add(words)
+                    if capture.is_complete:
+                        return capture
+
+            self._read(deadline, "no capture")
+
+    def wait_histogram(self, timeout):
+        """The next complete histogram dump."""
+        deadline = time.monotonic() + timeout
+        histogram = None
+        while True:
+            for words in self._records(HISTOGRAM_ID):
+                kind = words[0] >> 24
+                if kind == HISTOGRAM_RECORD_HEADER and len(words) >= 11:
+                    histogram = Histogram.from_header(words)
+                elif kind == HISTOGRAM_RECORD_DATA and histogram and words[0] & 0xFFFF == histogram.sequence:
+                    histogram.add(words)
+                if histogram and histogram.is_complete:
+                    return histogram
+
+            self._read(deadline, "no histogram")
+
+    def read_transients(self, duration):
+        """Event and summary records until duration seconds have passed."""
+        deadline = time.monotonic() + duration
+        while True:
+            for words in self._records(TRANSIENT_ID):
+                if len(words) >= 9:
+                    yield Transient(words)
+
+            try:
+                self._read(deadline, "")
+            except TimeoutError:
+                return
+
+    def read_segments(self, duration):
+        """Closed power state segments until duration seconds have passed."""
+        deadline = time.monotonic() + duration
+        while True:
+            for words in self._records(SEGMENT_ID):
+                if len(words) >= 8:
+                    yield Segment(words)
+
+            try:
+                self._read(deadline, "")
+            except TimeoutError:
+                return
+
+    def _wait_response(self, sequence):
+        deadline = time.monotonic() + self.timeout
+        while True:
+            for words in self._records(RESPONSE_ID):
+                response = Response(words)
+                if response.sequence == sequence:
+                    return response
+
+            self._read(deadline, f"no response to sequence {sequence}")
+
+    def _read(self, deadline, message):
+        remaining = deadline - time.monotonic()
+        if remaining <= 0 or not select.select([self.fd], [], [], remaining)[0]:
+            raise TimeoutError(message)
+        self.buffer += os.read(self.fd, 256)
+
+    def _records(self, record_id):
+        """Raw records with the given id from the buffered frames; everything else is dropped."""
+        while True:
+            end = self.buffer.find(b"\0")
+            if end < 0:
+                return
+            frame = bytes(self.buffer[:end])
+            del self.buffer[:end + 1]
+            if not frame:
+                continue
+
+            try:
+                payload = cobs_decode(frame)
+            except ValueError:
+                continue
+            if len(payload) < 12 or len(payload) % 4:
+                continue
+
+            header, _timestamp, *args = struct.unpack(f"<{len(payload) // 4}I", payload)
+            if header & HEADER_ID_MASK != record_id or len(args) != (header >> HEADER_COUNT_SHIFT) & HEADER_COUNT_MASK:
+                continue
+            yield args
+
+
+def parse_op(batch, text):
+    name, _, arguments = text.partition("=")
+    if name == "alert":
+        function, _, rest = arguments.partition(":")
+        limit, _, latch = rest.partition(":")
+        if function not in ALERT_FUNCTIONS or latch not in ("", "latch"):
+            raise argparse.ArgumentTypeError(f"alert needs function:limit[:latch], one of {', '.join(ALERT_FUNCTIONS)}")
+        batch.alert(function, float(limit) if limit else 0.0, latch == "latch")
+        return
+    if name == "segments":
+        if arguments in ("", "default"):
+            batch.segments()
+        else:
+            batch.segments([] if arguments == "off" else [int(value, 0) for value in arguments.split(",")])
+        return
+    if name == "hysteresis":
+        if not arguments:
+            raise argparse.ArgumentTypeError("hysteresis needs a release limit or off")
+        batch.hysteresis(None if arguments == "off" else float(arguments))
+        return
+
+    if name not in OP_NAMES:
+        raise argparse.ArgumentTypeError(f"unknown op {name}, one of {', '.join(OP_NAMES)}")
+
+    op = OP_NAMES[name]
+    if op >= OP_TELEMETRY:
+        batch.add(op, 0, int(arguments, 0) if arguments else 0)
+        return
+
+    device, _, value = arguments.partition(":")
+    if not value:
+        raise argparse.ArgumentTypeError(f"{name} needs device:value")
+    batch.add(op, int(device, 0), int(value, 0))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="serial port the firmware is on")
+    parser.add_argument("ops", nargs="+", help="op=device:value, applied as one batch")
+    parser.add_argument("--timeout", type=float, default=1.0, help="seconds to wait for the response (default: 1)")
+    parser.add_argument("--capture", metavar="CSV", help="then wait for a capture window and write it here")
+    parser.add_argument("--capture-timeout", type=float, default=60.0,
+                        help="seconds to wait for the capture or histogram (default: 60)")
+    parser.add_argument("--transients", type=float, metavar="SECONDS",
+                        help="then print event mode records for this many seconds")
+    parser.add_argument("--histogram", metavar="JSON", help="then wait for a histogram dump and write it here")
+    parser.add_argument("--segments", type=float, metavar="SECONDS",
+                        help="then print power state segments for this many seconds")
+    args = parser.parse_args()
+
+    batch = Batch()
+    try:
+        for text in args.ops:
+            parse_op(batch, text)
+    except (argparse.ArgumentTypeError, ValueError) as error:
+        parser.error(str(error))
+
+    with Client(args.port, timeout=args.timeout) as client:
+        response = client.send(batch)
+        print(response)
+        if not response.is_ok:
+            sys.exit(1)
+
+        if args.capture:
+            capture = client.wait_capture(args.capture_timeout)
+            print(capture)
+            with open(args.capture, "w") as out:
+                capture.write_csv(out)
+
+        if args.histogram:
+            histogram = client.wait_histogram(args.capture_timeout)
+            print(histogram)
+            with open(args.histogram, "w") as out:
+                json.dump(histogram.to_json(), out, indent=1)
+
+        if args.transients:
+            for record in client.read_transients(args.transients):
+                print(record)
+
+        if args.segments:
+            for segment in client.read_segments(args.segments):
+                print(segment)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,85 @@
+/*
+ * Host benchmark of the batch raw-to-engineering conversion in app/ina226/ina226_scale.c.
+ *
+ * Times ina226_scale_block, vectorized for whatever the compiler targets, against the plain
+ * ina226_scale_block_generic loop across block sizes, and checks both give the same bits.
+ *
+ * usage: cc -std=c2x -O2 -Iapp/ina226 tools/ina226_scale_bench.c app/ina226/ina226_scale.c \
+ *            app/ina226/ina226.c -o ina226_scale_bench && ./ina226_scale_bench
+ *        add -msse2 or -mavx2 to pick the variant; without either on x86-64 it is SSE2
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "ina226.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_BLOCK 4096U
+#define BENCH_ELEMENTS (1U << 24U)
+#define BENCH_SCALE 2.5e-6F
+
+typedef void (*bench_kernel_t)(int16_t const* raw, float32_t* scaled, size_t count, float32_t scale);
+
+static int16_t bench_raw[BENCH_MAX_BLOCK];
+static float32_t bench_generic[BENCH_MAX_BLOCK];
+static float32_t bench_vector[BENCH_MAX_BLOCK];
+
+static double bench_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+// ns per element over the same number of elements for every block size
+static double bench_run(bench_kernel_t kernel, float32_t* scaled, size_t block)
+{
+    size_t const repeats = BENCH_ELEMENTS / block;
+    double const start = bench_now_ns();
+
+    for (size_t i = 0U; i < repeats; ++i) {
+        kernel(bench_raw, scaled, block, BENCH_SCALE);
+        // keeps the calls from being merged or dropped
+        __asm__ volatile("" : : "r"(scaled) : "memory");
+    }
+
+    return (bench_now_ns() - start) / (double)(repeats * block);
+}
+
+int main(void)
+{
+    srand(1U);
+    for (size_t i = 0U; i < BENCH_MAX_BLOCK; ++i) {
+        bench_raw[i] = (int16_t)(rand() - RAND_MAX / 2);
+    }
+    bench_raw[0] = INT16_MIN;
+    bench_raw[1] = INT16_MAX;
+
+    int mismatches = 0;
+
+    printf("%8s %12s %12s %8s\n", "block", "generic ns", "block ns", "speedup");
+    for (size_t block = 1U; block <= BENCH_MAX_BLOCK; block *= 4U) {
+        // odd sizes exercise the scalar tail after the vector part
+        for (size_t size = block; size <= block + (block > 1U ? 3U : 0U); size += 3U) {
+            if (size > BENCH_MAX_BLOCK) {
+                break;
+            }
+
+            double const generic = bench_run(ina226_scale_block_generic, bench_generic, size);
+            double const vector = bench_run(ina226_scale_block, bench_vector, size);
+
+            if (memcmp(bench_generic, bench_vector, size * sizeof(float32_t)) != 0) {
+                printf("block %zu: results differ\n", size);
+                ++mismatches;
+            }
+
+            printf("%8zu %12.3f %12.3f %7.2fx\n", size, generic, vector, generic / vector);
+        }
+    }
+
+    return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""Decodes the deferred log stream sent over the UART back into text.
+
+Every record arrives as a COBS frame terminated by a zero byte and holds little-endian words:
+a header (bit 31 committed, bits 16..19 argument word count, bits 0..15 format id), the DWT
+cycle timestamp and the raw arguments. The format id is the address of the format string in
+the non-loaded logger_fmt section of the firmware ELF, which is where the text is read from.
+
+usage: logger_decode.py build/app/main/main.elf /dev/ttyUSB0
+       logger_decode.py build/app/main/main.elf capture.bin
+       cat capture.bin | logger_decode.py build/app/main/main.elf
+
+A serial port has to be in raw mode first, e.g. stty -F /dev/ttyUSB0 115200 raw -echo
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FORMAT_SECTION = "logger_fmt"
+
+HEADER_COUNT_SHIFT = 16
+HEADER_COUNT_MASK = 0xF
+HEADER_ID_MASK = 0xFFFF
+
+# records from here up carry words for other tools, e.g. command responses (ina226_client.py)
+RAW_ID_FIRST = 0xFF00
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+SPECIFIER = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\d+)?(?:\.(?P<precision>\d+))?"
+    r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conversion>[diouxXeEfFgGcsp%])"
+)
+
+
+class Elf:
+    """The few bits of a 32-bit little-endian ELF the decoder needs: sections by name and address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as file:
+            self.data = file.read()
+
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError(f"{path}: not a 32-bit little-endian ELF")
+
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x2E)
+
+        headers = [struct.unpack_from("<IIIIIIIIII", self.data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+
+        self.sections = []
+        for name, kind, flags, address, offset, size, *_ in headers:
+            self.sections.append({
+                "name": self._string(names[4] + name),
+                "kind": kind,
+                "flags": flags,
+                "address": address,
+                "offset": offset,
+                "size": size,
+            })
+
+    def _string(self, offset):
+        return self.data[offset:self.data.index(b"\0", offset)].decode("utf-8", "replace")
+
+    def section(self, name):
+        for section in self.sections:
+            if section["name"] == name:
+                return section
+        raise KeyError(f"no {name} section, was the firmware built with the deferred logger?")
+
+    def format_string(self, format_id):
+        section = self.section(FORMAT_SECTION)
+        if format_id >= section["size"]:
+            return None
+        return self._string(section["offset"] + format_id)
+
+    def string_at(self, address):
+        """Resolves a %s argument, a pointer into one of the loaded sections."""
+        for section in self.sections:
+            if not section["flags"] & SHF_ALLOC or section["kind"] == SHT_NOBITS:
+                continue
+            if section["address"] <= address < section["address"] + section["size"]:
+                return self._string(section["offset"] + address - section["address"])
+        return f"<0x{address:08x}>"
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    index = 0
+    while index < len(frame):
+        code = frame[index]
+        if code == 0:
+            raise ValueError("zero byte inside a frame")
+        block = frame[index + 1:index + code]
+        if len(block) != code - 1:
+            raise ValueError("truncated frame")
+        out += block
+        index += code
+        if code != 0xFF and index < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def to_signed(value, bits):
+    return value - (1 << bits) if value & (1 << (bits - 1)) else value
+
+
+def render(elf, format_string, args):
+    """printf over the raw argument words, consuming two for 64-bit values."""
+    words = iter(args)
+    missing = []
+
+    def next_word():
+        word = next(words, None)
+        if word is None:
+            missing.append(True)
+            return 0
+        return word
+
+    def substitute(match):
+        conversion = match["conversion"]
+        if conversion == "%":
+            return "%"
+
+        is_wide = match["length"] in ("ll", "j")
+        value = next_word()
+        if is_wide:
+            value |= next_word() << 32
+
+        spec = "%" + match["flags"] + (match["width"] or "")
+        if match["precision"] is not None:
+            spec += "." + match["precision"]
+
+        if conversion in "di":
+            return (spec + "d") % to_signed(value, 64 if is_wide else 32)
+        if conversion in "ouxX":
+            return (spec + conversion) % value
+        if conversion in "eEfFgG":
+            return (spec + conversion) % struct.unpack("<f", struct.pack("<I", value & 0xFFFFFFFF))[0]
+        if conversion == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conversion == "s":
+            return (spec + "s") % ("(null)" if value == 0 else elf.string_at(value))
+        return "0x%08x" % value
+
+    text = SPECIFIER.sub(substitute, format_string)
+    if missing:
+        text += " <missing arguments>"
+    return text
+
+
+def decode(elf, stream, clock_hz, out):
+    previous = None
+    elapsed = 0
+    buffer = bytearray()
+
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        buffer += chunk
+
+        while True:
+            end = buffer.find(b"\0")
+            if end < 0:
+                break
+            frame = bytes(buffer[:end])
+            del buffer[:end + 1]
+            if not frame:
+                continue
+
+            try:
+                payload = cobs_decode(frame)
+            except ValueError as error:
+                out.write(f"<bad frame: {error}>\n")
+                continue
+            if len(payload) < 8 or len(payload) % 4:
+                out.write(f"<bad record of {len(payload)} bytes>\n")
+                continue
+
+            header, timestamp, *args = struct.unpack(f"<{len(payload) // 4}I", payload)
+            if len(args) != (header >> HEADER_COUNT_SHIFT) & HEADER_COUNT_MASK:
+                out.write("<argument count mismatch>\n")
+                continue
+
+            # the cycle counter wraps every 2^32 cycles, 53 s at 80 MHz
+            if previous is not None:
+                elapsed += (timestamp - previous) & 0xFFFFFFFF
+            previous = timestamp
+
+            format_id = header & HEADER_ID_MASK
+            if format_id >= RAW_ID_FIRST:
+                words = " ".join(f"{arg:08x}" for arg in args)
+                out.write(f"{elapsed / clock_hz:12.6f} <raw 0x{format_id:04x}> {words}\n")
+                continue
+
+            format_string = elf.format_string(format_id)
+            if format_string is None:
+                out.write(f"{elapsed / clock_hz:12.6f} <unknown format id {format_id}>\n")
+                continue
+
+            out.write(f"{elapsed / clock_hz:12.6f} {render(elf, format_string, args)}\n")
+            out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF the stream was produced by")
+    parser.add_argument("input", nargs="?", help="serial port or capture file, stdin when omitted")
+    parser.add_argument("--clock", type=float, default=80e6, help="timestamp clock in Hz (default: 80e6)")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+
+    if args.input is None:
+        decode(elf, sys.stdin.buffer, args.clock, sys.stdout)
+    else:
+        with open(args.input, "rb", buffering=0) as stream:
+            decode(elf, stream, args.clock, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()